@@ -0,0 +1,134 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <iomanip>
+#include <cmath>
+
+#include "../include/utils.h"
+#include "../include/edge_extractor.h"
+#include "../include/kruskal.h"
+#include "../include/edge_generation.h"
+#include "../include/batch_mst.h"
+
+/**
+ * Throughput de muchas instancias chicas de MST: la API de una instancia a la
+ * vez (extractor nuevo, inserción, kruskal(), get_mst_edges(), liberar) frente a
+ * solve_mst_batch() sobre el mismo lote plano. Para cada N imprime en stdout una
+ * fila CSV por modo con instancias por segundo y verifica que los pesos coincidan.
+ */
+
+struct batch_options
+{
+    unsigned int min_log2 = 5;                 ///< Menor N (log2)
+    unsigned int max_log2 = 9;                 ///< Mayor N (log2)
+    unsigned int instances = 2000;             ///< Instancias por tamaño
+    size_t max_edges = size_t(1) << 24;        ///< Tope de aristas del lote (limita las instancias de los N grandes)
+    unsigned int threads = 1;                  ///< Hilos de ambos modos
+    unsigned int seed = 1234;                  ///< Semilla de los puntos
+    std::string extractor = "ArraySort";       ///< Extractor del modo una-a-la-vez
+};
+
+/**
+ * @brief Resuelve cada instancia con la API de una instancia, repartidas entre hilos
+ */
+std::vector<double> solve_one_by_one(const batch_options& opts, const MSTBatch& batch)
+{
+    std::vector<double> weights(batch.size());
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t i = next++; i < batch.size(); i = next++) {
+            EdgeExtractor* extractor = make_edge_extractor(opts.extractor);
+            const edge* edges = batch.instance_edges(i);
+            for (size_t k = 0; k < batch.instance_edge_count(i); ++k) extractor->insert_edge(edges[k]);
+            void* result = kruskal(extractor, true, kruskal_options{KRUSKAL_DEFAULT_BATCH, batch.num_nodes(i)});
+            weights[i] = get_mst_weight(result);
+            volatile size_t sink = get_mst_edges(result).size();
+            (void)sink;
+            free_kruskal_result(result);
+            delete extractor;
+        }
+    };
+    std::vector<std::jthread> pool;
+    for (unsigned int t = 0; t < opts.threads; ++t) pool.emplace_back(work);
+    return weights;
+}
+
+void print_row(size_t n, size_t instances, unsigned int threads, const std::string& mode, double seconds, double speedup)
+{
+    std::cout << n << "," << instances << "," << threads << "," << mode << "," << std::fixed << std::setprecision(6)
+              << seconds << "," << std::setprecision(1) << instances / seconds << "," << std::setprecision(2)
+              << speedup << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    batch_options opts;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        std::string value = argv[i + 1];
+        try {
+            if (key == "--min-log2") opts.min_log2 = std::stoul(value);
+            else if (key == "--max-log2") opts.max_log2 = std::stoul(value);
+            else if (key == "--instances") opts.instances = std::stoul(value);
+            else if (key == "--max-edges") opts.max_edges = std::stoull(value);
+            else if (key == "--threads") opts.threads = std::stoul(value);
+            else if (key == "--seed") opts.seed = std::stoul(value);
+            else if (key == "--extractor") opts.extractor = value;
+            else {
+                std::cerr << "Opción desconocida: " << key << std::endl;
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: valor inválido para " << key << ": '" << value << "'" << std::endl;
+            return 1;
+        }
+    }
+    if (opts.min_log2 < 1 || opts.min_log2 > opts.max_log2 || opts.max_log2 > 14 || opts.instances == 0 || opts.threads == 0) {
+        std::cerr << "Error: se requiere 1 <= min-log2 <= max-log2 <= 14, instances > 0 y threads > 0" << std::endl;
+        return 1;
+    }
+
+    std::cout << "N,Instances,Threads,Mode,Seconds,InstancesPerSec,Speedup" << std::endl;
+    std::mt19937 gen(opts.seed);
+    std::uniform_real_distribution<double> distrib(0.0, 1.0);
+    bool ok = true;
+    for (unsigned int log2_n = opts.min_log2; log2_n <= opts.max_log2; ++log2_n) {
+        const size_t n = size_t(1) << log2_n;
+        const size_t edges_per_instance = n * (n - 1) / 2;
+        const size_t instances = std::clamp<size_t>(opts.max_edges / edges_per_instance, 1, opts.instances);
+
+        MSTBatch batch;
+        batch.reserve(instances, instances * edges_per_instance);
+        std::vector<node> points(n);
+        for (size_t i = 0; i < instances; ++i) {
+            for (node& p : points) p = {distrib(gen), distrib(gen)};
+            batch.add_points(points);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<double> expected = solve_one_by_one(opts, batch);
+        const double one_by_one = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        mst_batch_result result = solve_mst_batch(batch, true, opts.threads);
+        const double batched = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (size_t i = 0; i < instances; ++i) {
+            if (std::abs(result.weight[i] - expected[i]) > 1e-9 * std::max(1.0, expected[i])
+                || result.mst_size[i] != static_cast<int>(n) - 1) {
+                std::cerr << "Error: la instancia " << i << " de N=" << n << " no coincide con kruskal()" << std::endl;
+                ok = false;
+                break;
+            }
+        }
+
+        print_row(n, instances, opts.threads, opts.extractor, one_by_one, 1.0);
+        print_row(n, instances, opts.threads, "batch", batched, one_by_one / batched);
+    }
+    return ok ? 0 : 1;
+}
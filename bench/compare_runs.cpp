@@ -0,0 +1,198 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <string>
+#include <iomanip>
+#include <algorithm>
+
+#include "../include/stats.h"
+
+/**
+ * Comparador de regresiones entre dos corridas del experimento (df.csv o
+ * bench_runs.csv): une las filas de la línea base y del candidato por
+ * (N, EdgeExtractorName, KruskalOptiPath) — y Clusters si ambas lo tienen —,
+ * calcula el speedup mediana(base) / mediana(candidato) de la métrica elegida
+ * con un intervalo bootstrap y marca como regresión toda configuración cuyo
+ * intervalo completo queda por debajo de 1 - threshold. Las configuraciones más
+ * cortas que --min-seconds se listan como too-short sin juzgarse.
+ * Imprime un CSV en stdout. Código de salida: 0 sin regresiones, 1 con alguna
+ * regresión, 2 si una entrada no se pudo leer o no comparte configuraciones.
+ */
+
+struct compare_options
+{
+    std::string baseline;                 ///< CSV de la línea base
+    std::string candidate;                ///< CSV del candidato
+    std::string metric = "TimeKruskal";   ///< Columna comparada, o "Total" (TimeInsertion + TimeKruskal)
+    double threshold = 0.05;              ///< Pérdida tolerada: regresión si speedup < 1 - threshold con confianza
+    unsigned int resamples = 2000;        ///< Remuestreos bootstrap
+    double confidence = 0.95;             ///< Nivel de confianza del intervalo
+    unsigned int seed = 1234;             ///< Semilla del bootstrap
+    double min_seconds = 0.0;             ///< Configuraciones con mediana base menor se informan pero no se juzgan (ruido)
+};
+
+using config_key = std::tuple<unsigned long long, std::string, std::string, std::string>;
+
+/**
+ * @brief Mediciones de la métrica por configuración
+ */
+using run_table = std::map<config_key, std::vector<double>>;
+
+std::vector<std::string> split_row(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) fields.push_back(field);
+    return fields;
+}
+
+bool has_column(const std::string& path, const std::string& name)
+{
+    std::ifstream in(path);
+    std::string line;
+    if (!std::getline(in, line)) return false;
+    const std::vector<std::string> columns = split_row(line);
+    return std::find(columns.begin(), columns.end(), name) != columns.end();
+}
+
+/**
+ * @brief Lee un CSV de resultados; las corridas de calentamiento (Warmup = 1) se ignoran
+ * @param use_clusters Incluir la columna Clusters en la clave (si no, se mezclan todos los k)
+ */
+bool load_run(const std::string& path, const std::string& metric, bool use_clusters, run_table& table)
+{
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line)) {
+        std::cerr << "Error: no se pudo leer " << path << std::endl;
+        return false;
+    }
+    const std::vector<std::string> columns = split_row(line);
+    auto column = [&](const std::string& name) -> int {
+        auto it = std::find(columns.begin(), columns.end(), name);
+        return it == columns.end() ? -1 : static_cast<int>(it - columns.begin());
+    };
+    const int col_n = column("N");
+    const int col_extractor = column("EdgeExtractorName");
+    const int col_opti = column("KruskalOptiPath");
+    const int col_insertion = column("TimeInsertion");
+    const int col_kruskal = column("TimeKruskal");
+    const int col_metric = metric == "Total" ? -1 : column(metric);
+    const int col_clusters = column("Clusters");
+    const int col_warmup = column("Warmup");
+    if (col_n < 0 || col_extractor < 0 || col_opti < 0 || (metric == "Total" ? col_insertion < 0 || col_kruskal < 0 : col_metric < 0)) {
+        std::cerr << "Error: " << path << " no tiene las columnas N, EdgeExtractorName, KruskalOptiPath y " << metric << std::endl;
+        return false;
+    }
+
+    while (std::getline(in, line)) {
+        const std::vector<std::string> fields = split_row(line);
+        if (fields.size() != columns.size()) continue;
+        if (col_warmup >= 0 && fields[col_warmup] == "1") continue;
+        try {
+            const double value = metric == "Total" ? std::stod(fields[col_insertion]) + std::stod(fields[col_kruskal])
+                                                   : std::stod(fields[col_metric]);
+            config_key key{std::stoull(fields[col_n]), fields[col_extractor], fields[col_opti],
+                           use_clusters && col_clusters >= 0 ? fields[col_clusters] : ""};
+            table[key].push_back(value);
+        } catch (const std::exception&) {
+            // Filas ilegibles (p.ej. truncadas) no participan de la comparación
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    compare_options opts;
+    auto usage = [&]() {
+        std::cerr << "Uso: " << argv[0] << " --baseline BASE.csv --candidate CAND.csv [--metric TimeKruskal|TimeInsertion|Total]"
+                  << " [--threshold 0.05] [--resamples 2000] [--confidence 0.95] [--seed 1234] [--min-seconds 0]" << std::endl;
+    };
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        std::string value = argv[i + 1];
+        try {
+            if (key == "--baseline") opts.baseline = value;
+            else if (key == "--candidate") opts.candidate = value;
+            else if (key == "--metric") opts.metric = value;
+            else if (key == "--threshold") opts.threshold = std::stod(value);
+            else if (key == "--resamples") opts.resamples = std::stoul(value);
+            else if (key == "--confidence") opts.confidence = std::stod(value);
+            else if (key == "--seed") opts.seed = std::stoul(value);
+            else if (key == "--min-seconds") opts.min_seconds = std::stod(value);
+            else {
+                std::cerr << "Opción desconocida: " << key << std::endl;
+                return 2;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: valor inválido para " << key << ": '" << value << "'" << std::endl;
+            usage();
+            return 2;
+        }
+    }
+    if (opts.baseline.empty() || opts.candidate.empty() || opts.threshold < 0 || opts.threshold >= 1
+        || opts.resamples == 0 || opts.confidence <= 0 || opts.confidence >= 1) {
+        usage();
+        return 2;
+    }
+
+    // Clusters entra en la clave solo si ambas corridas la tienen
+    const bool use_clusters = has_column(opts.baseline, "Clusters") && has_column(opts.candidate, "Clusters");
+    run_table base, cand;
+    if (!load_run(opts.baseline, opts.metric, use_clusters, base) || !load_run(opts.candidate, opts.metric, use_clusters, cand)) return 2;
+
+    std::cout << "N,EdgeExtractorName,KruskalOptiPath" << (use_clusters ? ",Clusters" : "")
+              << ",BaselineCount,CandidateCount,BaselineMedian,CandidateMedian,Speedup,CILow,CIHigh,Status" << std::endl;
+    unsigned int compared = 0, regressions = 0, improvements = 0;
+    for (const auto& [key, base_samples] : base) {
+        auto it = cand.find(key);
+        if (it == cand.end()) {
+            std::cerr << "Aviso: N=" << std::get<0>(key) << " " << std::get<1>(key) << " opti_path=" << std::get<2>(key)
+                      << " no está en el candidato" << std::endl;
+            continue;
+        }
+        const std::vector<double>& cand_samples = it->second;
+        const double base_median = median(base_samples);
+        const double cand_median = median(cand_samples);
+        const double speedup = base_median / cand_median;
+        // Semilla distinta por configuración, pero la misma en cada ejecución del comparador
+        const auto [low, high] = bootstrap_median_ratio_ci(base_samples, cand_samples, opts.resamples,
+                                                           opts.seed + compared, opts.confidence);
+        std::string status = "ok";
+        if (base_median < opts.min_seconds) {
+            status = "too-short";
+        } else if (high < 1.0 - opts.threshold) {
+            status = "regression";
+            regressions++;
+        } else if (low > 1.0 + opts.threshold) {
+            status = "improvement";
+            improvements++;
+        }
+        compared++;
+
+        std::cout << std::get<0>(key) << "," << std::get<1>(key) << "," << std::get<2>(key);
+        if (use_clusters) std::cout << "," << std::get<3>(key);
+        std::cout << "," << base_samples.size() << "," << cand_samples.size() << std::setprecision(6)
+                  << "," << base_median << "," << cand_median << std::fixed << std::setprecision(4)
+                  << "," << speedup << "," << low << "," << high << std::defaultfloat << "," << status << std::endl;
+    }
+    for (const auto& [key, samples] : cand) {
+        if (!base.count(key)) {
+            std::cerr << "Aviso: N=" << std::get<0>(key) << " " << std::get<1>(key) << " opti_path=" << std::get<2>(key)
+                      << " no está en la línea base" << std::endl;
+        }
+    }
+
+    std::cerr << compared << " configuraciones comparadas (" << opts.metric << "): " << regressions << " regresiones, "
+              << improvements << " mejoras (umbral " << opts.threshold * 100 << "%, IC " << opts.confidence * 100 << "%)" << std::endl;
+    if (compared == 0) {
+        std::cerr << "Error: las corridas no comparten ninguna configuración" << std::endl;
+        return 2;
+    }
+    return regressions > 0 ? 1 : 0;
+}
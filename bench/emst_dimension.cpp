@@ -0,0 +1,164 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <type_traits>
+
+#include "../include/utils.h"
+#include "../include/edge_extractor.h"
+#include "../include/kruskal.h"
+#include "../include/edge_generation.h"
+#include "../include/metric.h"
+#include "../include/point_set.h"
+#include "../include/boruvka_emst.h"
+
+/**
+ * MST geométrico en dimensión D: Borůvka dual-tree sobre kd-tree frente a
+ * generar las n(n-1)/2 aristas y ejecutar kruskal() con ArraySort (solo hasta
+ * --max-complete-log2, que acota la memoria del grafo completo). Imprime una fila
+ * CSV por (D, N, motor) y verifica que ambos pesos coincidan.
+ */
+
+struct emst_options
+{
+    std::vector<size_t> dims = {2, 3, 4, 8, 16}; ///< Dimensiones a medir (2..EMST_MAX_DIMENSION)
+    unsigned int min_log2 = 10;                  ///< Menor N (log2)
+    unsigned int max_log2 = 13;                  ///< Mayor N (log2)
+    unsigned int max_complete_log2 = 12;         ///< Mayor N (log2) con la línea base de grafo completo
+    metric_kind metric = metric_kind::sqeuclidean; ///< Métrica
+    std::string metric_name = "sqeuclidean";
+    unsigned int seed = 1234;                    ///< Semilla de los puntos
+};
+
+/**
+ * @brief Llama a f con std::integral_constant<size_t, d> si 2 <= d <= EMST_MAX_DIMENSION
+ */
+template <size_t D = 2, typename F>
+bool with_dimension(size_t d, F&& f)
+{
+    if constexpr (D > EMST_MAX_DIMENSION) {
+        return false;
+    } else {
+        if (d == D) {
+            f(std::integral_constant<size_t, D>{});
+            return true;
+        }
+        return with_dimension<D + 1>(d, f);
+    }
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void print_row(const emst_options& opts, size_t d, size_t n, const std::string& engine, double seconds, double weight,
+               unsigned long long evaluations, unsigned int rounds, double speedup)
+{
+    std::cout << d << "," << n << "," << opts.metric_name << "," << engine << "," << std::fixed << std::setprecision(6)
+              << seconds << "," << std::defaultfloat << std::setprecision(10) << weight << "," << evaluations << ","
+              << rounds << ",";
+    if (speedup > 0) std::cout << std::fixed << std::setprecision(2) << speedup << std::defaultfloat;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Mide ambos motores en dimensión D para todos los N
+ * @return false si algún peso no coincide con kruskal()
+ */
+template <size_t D, typename Metric>
+bool run_dimension(const emst_options& opts)
+{
+    bool ok = true;
+    std::mt19937 gen(opts.seed + D);
+    for (unsigned int log2_n = opts.min_log2; log2_n <= opts.max_log2; ++log2_n) {
+        const size_t n = size_t(1) << log2_n;
+        const PointSet<D> points = PointSet<D>::uniform(n, gen);
+
+        auto start = std::chrono::steady_clock::now();
+        const emst_result tree = dual_tree_boruvka<D, Metric>(points);
+        const double boruvka = seconds_since(start);
+
+        double speedup = 0.0;
+        if (log2_n <= opts.max_complete_log2) {
+            start = std::chrono::steady_clock::now();
+            edge_vector edges;
+            generate_complete_edges<Metric>(points, edges);
+            ArraySort extractor;
+            for (const edge& e : edges) extractor.insert_edge(e);
+            edge_vector().swap(edges);
+            void* result = kruskal(&extractor, true, kruskal_options{KRUSKAL_DEFAULT_BATCH, static_cast<int>(n)});
+            const double complete = seconds_since(start);
+            const double weight = get_mst_weight(result);
+            free_kruskal_result(result);
+
+            if (std::abs(weight - tree.weight) > 1e-9 * std::max(1.0, weight) || tree.edges.size() != n - 1) {
+                std::cerr << "Error: D=" << D << " N=" << n << ": Borůvka pesa " << tree.weight << " y kruskal() " << weight << std::endl;
+                ok = false;
+            }
+            print_row(opts, D, n, "kruskal-complete", complete, weight, n * (n - 1) / 2, 0, 0.0);
+            speedup = complete / boruvka;
+        }
+        print_row(opts, D, n, "dual-tree-boruvka", boruvka, tree.weight, tree.distance_evaluations, tree.rounds, speedup);
+    }
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    emst_options opts;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        std::string value = argv[i + 1];
+        try {
+            if (key == "--dims") {
+                opts.dims.clear();
+                std::stringstream ss(value);
+                std::string item;
+                while (std::getline(ss, item, ',')) opts.dims.push_back(std::stoul(item));
+            }
+            else if (key == "--min-log2") opts.min_log2 = std::stoul(value);
+            else if (key == "--max-log2") opts.max_log2 = std::stoul(value);
+            else if (key == "--max-complete-log2") opts.max_complete_log2 = std::stoul(value);
+            else if (key == "--metric") {
+                if (!parse_metric(value, opts.metric)) {
+                    std::cerr << "Error: metric solo acepta sqeuclidean, l1 o linf" << std::endl;
+                    return 1;
+                }
+                opts.metric_name = value;
+            }
+            else if (key == "--seed") opts.seed = std::stoul(value);
+            else {
+                std::cerr << "Opción desconocida: " << key << std::endl;
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: valor inválido para " << key << ": '" << value << "'" << std::endl;
+            return 1;
+        }
+    }
+    if (opts.min_log2 < 1 || opts.min_log2 > opts.max_log2 || opts.max_log2 > 24 || opts.dims.empty()) {
+        std::cerr << "Error: se requiere 1 <= min-log2 <= max-log2 <= 24 y al menos una dimensión" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Dim,N,Metric,Engine,Seconds,Weight,DistanceEvaluations,Rounds,Speedup" << std::endl;
+    bool ok = true;
+    for (size_t d : opts.dims) {
+        const bool supported = with_dimension(d, [&](auto dimension) {
+            with_metric(opts.metric, [&](auto metric) {
+                ok = run_dimension<decltype(dimension)::value, decltype(metric)>(opts) && ok;
+            });
+        });
+        if (!supported) {
+            std::cerr << "Error: dimensión " << d << " fuera de 2.." << EMST_MAX_DIMENSION << std::endl;
+            return 1;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <iomanip>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../include/stats.h"
+
+/**
+ * Generador de carga del modo servicio (main.o --serve unix:RUTA).
+ * Cada cliente abre una conexión y envía peticiones "points N" una tras otra
+ * (ciclo cerrado), midiendo la latencia de cada una de punta a punta. Con
+ * --cold BINARIO, en vez de usar el socket cada petición lanza un proceso nuevo
+ * "BINARIO --serve stdin", la línea base sin buffers ni hilos precalentados.
+ * Imprime en stdout una fila CSV con throughput y percentiles de latencia.
+ */
+
+struct load_options
+{
+    std::string socket_path = "/tmp/mst.sock"; ///< Socket del servicio
+    std::string cold_binary;                   ///< Binario para el modo un-proceso-por-petición (vacío = socket)
+    unsigned int clients = 4;                  ///< Conexiones concurrentes
+    unsigned int requests = 100;               ///< Peticiones por cliente
+    unsigned int log2_n = 10;                  ///< Puntos por petición (log2)
+    unsigned int seed = 1234;                  ///< Semilla de los puntos
+    bool shutdown = false;                     ///< Enviar shutdown al servicio al terminar
+};
+
+/**
+ * @brief Petición "points N" con puntos uniformes en [0,1]^2, ya formateada
+ */
+std::string make_request(unsigned int n, std::mt19937& gen)
+{
+    std::uniform_real_distribution<double> distrib(0.0, 1.0);
+    std::string text = "points " + std::to_string(n) + "\n";
+    char line[64];
+    for (unsigned int i = 0; i < n; ++i) {
+        std::snprintf(line, sizeof(line), "%.17g %.17g\n", distrib(gen), distrib(gen));
+        text += line;
+    }
+    return text;
+}
+
+/**
+ * @brief Lee una respuesta "ok PESO K" y sus K aristas
+ * @return false si el servicio respondió error o cerró la conexión
+ */
+bool read_response(FILE* in)
+{
+    char status[16];
+    double weight = 0;
+    size_t k = 0;
+    if (std::fscanf(in, "%15s", status) != 1 || std::strcmp(status, "ok") != 0) return false;
+    if (std::fscanf(in, "%lf %zu", &weight, &k) != 2) return false;
+    for (size_t i = 0; i < k; ++i) {
+        int u, v;
+        double w;
+        if (std::fscanf(in, "%d %d %lf", &u, &v, &w) != 3) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Conexión al servicio, con un stream para cada sentido
+ * Un único FILE* "r+" sobre un socket no sirve: alternar escritura y lectura
+ * exige fseek, que en un socket falla.
+ */
+struct connection
+{
+    FILE* in = nullptr;
+    FILE* out = nullptr;
+
+    void close()
+    {
+        if (out) std::fclose(out);
+        if (in) std::fclose(in);
+        in = out = nullptr;
+    }
+};
+
+bool connect_service(const std::string& path, connection& conn)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) return false;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return false;
+    }
+    conn.in = fdopen(fd, "r");
+    conn.out = fdopen(dup(fd), "w");
+    if (!conn.in || !conn.out) {
+        conn.close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Un cliente: envía sus peticiones y guarda la latencia de cada una en ms
+ * @return false si alguna petición falló
+ */
+bool run_client(const load_options& opts, unsigned int id, std::vector<double>& latencies)
+{
+    std::mt19937 gen(opts.seed + id);
+    std::vector<std::string> requests;
+    for (unsigned int r = 0; r < opts.requests; ++r) requests.push_back(make_request(1u << opts.log2_n, gen));
+
+    connection conn;
+    std::string request_file;
+    if (opts.cold_binary.empty()) {
+        if (!connect_service(opts.socket_path, conn)) return false;
+    } else {
+        request_file = "/tmp/load_gen_" + std::to_string(::getpid()) + "_" + std::to_string(id) + ".txt";
+    }
+
+    bool ok = true;
+    for (const std::string& request : requests) {
+        auto start = std::chrono::steady_clock::now();
+        if (conn.out) {
+            std::fwrite(request.data(), 1, request.size(), conn.out);
+            std::fflush(conn.out);
+            ok = read_response(conn.in);
+        } else {
+            FILE* file = std::fopen(request_file.c_str(), "w");
+            if (!file) return false;
+            std::fwrite(request.data(), 1, request.size(), file);
+            std::fclose(file);
+            FILE* process = ::popen((opts.cold_binary + " --serve stdin < " + request_file).c_str(), "r");
+            ok = process && read_response(process);
+            if (process) ::pclose(process);
+        }
+        auto end = std::chrono::steady_clock::now();
+        if (!ok) break;
+        latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    if (conn.out) {
+        std::fputs("quit\n", conn.out);
+        conn.close();
+    } else {
+        std::remove(request_file.c_str());
+    }
+    return ok;
+}
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+int main(int argc, char** argv)
+{
+    load_options opts;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        std::string value = argv[i + 1];
+        try {
+            if (key == "--socket") opts.socket_path = value;
+            else if (key == "--cold") opts.cold_binary = value;
+            else if (key == "--clients") opts.clients = std::stoul(value);
+            else if (key == "--requests") opts.requests = std::stoul(value);
+            else if (key == "--log2-n") opts.log2_n = std::stoul(value);
+            else if (key == "--seed") opts.seed = std::stoul(value);
+            else if (key == "--shutdown") opts.shutdown = std::stoul(value) != 0;
+            else {
+                std::cerr << "Opción desconocida: " << key << std::endl;
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: valor inválido para " << key << ": '" << value << "'" << std::endl;
+            return 1;
+        }
+    }
+    if (opts.clients == 0 || opts.requests == 0 || opts.log2_n > 24) {
+        std::cerr << "Error: clients y requests deben ser mayores que 0 y log2-n a lo más 24" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<double>> latencies(opts.clients);
+    std::vector<char> ok(opts.clients, 0);
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> clients;
+        for (unsigned int c = 0; c < opts.clients; ++c) {
+            clients.emplace_back([&, c]() { ok[c] = run_client(opts, c, latencies[c]); });
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (opts.shutdown && opts.cold_binary.empty()) {
+        connection conn;
+        if (connect_service(opts.socket_path, conn)) {
+            std::fputs("shutdown\n", conn.out);
+            conn.close();
+        }
+    }
+
+    std::vector<double> all;
+    for (const std::vector<double>& client : latencies) all.insert(all.end(), client.begin(), client.end());
+    std::sort(all.begin(), all.end());
+
+    std::cout << "Mode,Clients,Requests,N,Seconds,RequestsPerSec,P50Ms,P99Ms,MaxMs" << std::endl;
+    std::cout << (opts.cold_binary.empty() ? "service" : "cold") << "," << opts.clients << "," << all.size() << ","
+              << (1u << opts.log2_n) << "," << std::fixed << std::setprecision(3) << seconds << ","
+              << all.size() / seconds << "," << median(all) << "," << percentile(all, 0.99) << ","
+              << (all.empty() ? 0.0 : all.back()) << std::endl;
+
+    if (std::find(ok.begin(), ok.end(), 0) != ok.end()) {
+        std::cerr << "Error: alguna petición falló o no se pudo conectar a " << opts.socket_path << std::endl;
+        return 1;
+    }
+    return 0;
+}
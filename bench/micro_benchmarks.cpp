@@ -0,0 +1,384 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <functional>
+#include <iomanip>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "../include/utils.h"
+#include "../include/edge_extractor.h"
+#include "../include/kruskal.h"
+#include "../include/edge_generation.h"
+#include "../include/stats.h"
+#include "../include/perf_counters.h"
+#include "../src/union_find.hpp"
+
+/**
+ * Micro-benchmarks de las primitivas de Kruskal medidas por separado:
+ * UnionFind::find/unite con distintos patrones de acceso e insert_edge/extract_min
+ * de cada extractor, con tamaños desde residentes en L1 hasta residentes en DRAM.
+ * Imprime un CSV en stdout con la mediana de ns/op de varias repeticiones y, para
+ * los extractores, la mediana de fallos de LLC por operación (vacía sin perf).
+ */
+
+// Evita que el compilador elimine los resultados de las operaciones medidas
+volatile long long sink = 0;
+
+struct bench_options
+{
+    unsigned int min_log2 = 10;       ///< Menor tamaño (log2 de elementos)
+    unsigned int max_log2_uf = 22;    ///< Mayor tamaño para Union-Find (32 MB, residente en DRAM)
+    unsigned int max_log2_edges = 22; ///< Mayor tamaño para extractores (64 MB de aristas)
+    unsigned int reps = 5;            ///< Repeticiones por medición
+};
+
+/**
+ * @brief Mide una función que realiza ops operaciones y retorna la mediana de ns/op
+ * @param reps Repeticiones
+ * @param ops Operaciones por repetición
+ * @param setup Prepara el estado (no se mide)
+ * @param body Operaciones medidas
+ */
+double measure_ns_per_op(unsigned int reps, size_t ops, const std::function<void()>& setup, const std::function<void()>& body)
+{
+    std::vector<double> samples;
+    for (unsigned int r = 0; r < reps; ++r) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+    }
+    return median(samples);
+}
+
+/**
+ * @brief Como measure_ns_per_op(), contando además los fallos de LLC del cuerpo
+ * Usa los mismos PerfCounters que measure_phase() en el experimento principal.
+ * @param llc_per_op Mediana de fallos de LLC por operación (NaN si el contador no está disponible)
+ */
+double measure_ns_per_op(unsigned int reps, size_t ops, const std::function<void()>& setup, const std::function<void()>& body,
+                         double& llc_per_op)
+{
+    static PerfCounters counters;
+    std::vector<double> samples, misses;
+    for (unsigned int r = 0; r < reps; ++r) {
+        setup();
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        const perf_sample sample = counters.stop();
+        samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+        if (sample.valid[PERF_LLC_MISSES]) misses.push_back(static_cast<double>(sample.value[PERF_LLC_MISSES]) / ops);
+    }
+    llc_per_op = misses.empty() ? std::numeric_limits<double>::quiet_NaN() : median(misses);
+    return median(samples);
+}
+
+void print_row(const std::string& primitive, const std::string& variant, const std::string& pattern,
+               size_t size, size_t bytes, size_t ops, double ns_per_op,
+               double llc_per_op = std::numeric_limits<double>::quiet_NaN())
+{
+    std::cout << primitive << "," << variant << "," << pattern << "," << size << "," << bytes << ","
+              << ops << "," << std::fixed << std::setprecision(3) << ns_per_op << ",";
+    if (!std::isnan(llc_per_op)) std::cout << std::setprecision(4) << llc_per_op;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Traza de pares (u, v) que consulta Kruskal sobre puntos aleatorios
+ * Para no generar n^2 aristas se usan solo pares de celdas vecinas en una grilla
+ * con ~2 puntos por celda, que contiene las aristas cortas que Kruskal procesa primero.
+ */
+std::vector<std::pair<int, int>> kruskal_trace(int n, std::mt19937& gen)
+{
+    std::uniform_real_distribution<double> distrib(0.0, 1.0);
+    std::vector<node> points(n);
+    for (node& p : points) p = {distrib(gen), distrib(gen)};
+
+    const int cells = std::max(1, static_cast<int>(std::sqrt(n / 2.0)));
+    std::vector<std::vector<int>> grid(cells * cells);
+    auto cell_of = [&](double c) { return std::min(cells - 1, static_cast<int>(c * cells)); };
+    for (int i = 0; i < n; ++i) grid[cell_of(points[i].y) * cells + cell_of(points[i].x)].push_back(i);
+
+    std::vector<edge> edges;
+    for (int cy = 0; cy < cells; ++cy) {
+        for (int cx = 0; cx < cells; ++cx) {
+            for (int i : grid[cy * cells + cx]) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        int ny = cy + dy, nx = cx + dx;
+                        if (ny < 0 || nx < 0 || ny >= cells || nx >= cells) continue;
+                        for (int j : grid[ny * cells + nx]) {
+                            if (i < j) edges.emplace_back(i, j, distance(points[i], points[j]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<std::pair<int, int>> trace;
+    trace.reserve(edges.size());
+    for (const edge& e : edges) trace.emplace_back(e.u, e.v);
+    return trace;
+}
+
+void bench_union_find(const bench_options& opts)
+{
+    std::mt19937 gen(1234);
+    for (unsigned int lg = opts.min_log2; lg <= opts.max_log2_uf; lg += 2) {
+        const int n = 1 << lg;
+        const size_t bytes = 2 * sizeof(int) * static_cast<size_t>(n);
+
+        // Patrón aleatorio: pares uniformes
+        std::uniform_int_distribution<int> node_dis(0, n - 1);
+        std::vector<std::pair<int, int>> random_pairs(n);
+        for (auto& p : random_pairs) p = {node_dis(gen), node_dis(gen)};
+
+        // Patrón adversarial: uniones de árboles de igual tamaño (profundidad log n).
+        // Con estas uniones el padre de x es x | (x + 1), así que la profundidad de x
+        // es lg - popcount(x) y las hojas más profundas tienen a lo más un bit encendido
+        std::vector<std::pair<int, int>> chain_unions;
+        for (int step = 1; step < n; step <<= 1) {
+            for (int i = 0; i + step < n; i += 2 * step) chain_unions.emplace_back(i + step, i);
+        }
+        std::vector<int> deep_leaves;
+        for (int i = 0; i < n; ++i) {
+            if (std::popcount(static_cast<unsigned int>(i)) <= 1) deep_leaves.push_back(i);
+        }
+
+        std::vector<std::pair<int, int>> trace = kruskal_trace(n, gen);
+
+        for (bool compression : {false, true}) {
+            const std::string variant = compression ? "PathCompression" : "Basic";
+            UnionFind* uf = nullptr;
+            auto reset = [&]() { delete uf; uf = new UnionFind(n, compression); };
+
+            double ns = measure_ns_per_op(opts.reps, random_pairs.size(), reset, [&]() {
+                for (const auto& [a, b] : random_pairs) uf->unite(a, b);
+            });
+            print_row("UnionFind::unite", variant, "random", n, bytes, random_pairs.size(), ns);
+
+            const size_t find_ops = 4 * static_cast<size_t>(n);
+            ns = measure_ns_per_op(opts.reps, find_ops, [&]() {
+                reset();
+                for (const auto& [a, b] : random_pairs) uf->unite(a, b);
+            }, [&]() {
+                long long acc = 0;
+                for (size_t i = 0; i < find_ops; ++i) acc += uf->find(random_pairs[i % random_pairs.size()].first);
+                sink = sink + acc;
+            });
+            print_row("UnionFind::find", variant, "random", n, bytes, find_ops, ns);
+
+            ns = measure_ns_per_op(opts.reps, chain_unions.size(), reset, [&]() {
+                for (const auto& [a, b] : chain_unions) uf->unite(a, b);
+            });
+            print_row("UnionFind::unite", variant, "adversarial", n, bytes, chain_unions.size(), ns);
+
+            ns = measure_ns_per_op(opts.reps, find_ops, [&]() {
+                reset();
+                for (const auto& [a, b] : chain_unions) uf->unite(a, b);
+            }, [&]() {
+                long long acc = 0;
+                for (size_t i = 0; i < find_ops; ++i) acc += uf->find(deep_leaves[i % deep_leaves.size()]);
+                sink = sink + acc;
+            });
+            print_row("UnionFind::find", variant, "adversarial", n, bytes, find_ops, ns);
+
+            // Traza de Kruskal: connected() + unite() sobre las aristas en orden de peso
+            ns = measure_ns_per_op(opts.reps, trace.size(), reset, [&]() {
+                long long accepted = 0;
+                for (const auto& [a, b] : trace) {
+                    if (!uf->connected(a, b)) {
+                        uf->unite(a, b);
+                        accepted++;
+                    }
+                }
+                sink = sink + accepted;
+            });
+            print_row("UnionFind::connected+unite", variant, "kruskal-trace", n, bytes, trace.size(), ns);
+
+            delete uf;
+        }
+    }
+}
+
+void bench_extractors(const bench_options& opts)
+{
+    const std::vector<std::string> names = {"ArraySort", "HeapMin", "RunMerge", "SequenceHeap"};
+    std::mt19937 gen(4321);
+    std::uniform_real_distribution<double> weight_dis(0.0, 2.0);
+
+    for (unsigned int lg = opts.min_log2; lg <= opts.max_log2_edges; lg += 2) {
+        const size_t m = size_t(1) << lg;
+        const size_t bytes = m * sizeof(edge);
+        std::vector<edge> edges(m);
+        for (size_t i = 0; i < m; ++i) edges[i] = edge(i % 4096, (i * 7) % 4096, weight_dis(gen));
+
+        for (const std::string& name : names) {
+            EdgeExtractor* extractor = nullptr;
+            auto reset = [&]() { delete extractor; extractor = make_edge_extractor(name); };
+            auto fill = [&]() {
+                reset();
+                for (const edge& e : edges) extractor->insert_edge(e);
+            };
+
+            double llc = 0.0;
+            double ns = measure_ns_per_op(opts.reps, m, reset, [&]() {
+                for (const edge& e : edges) extractor->insert_edge(e);
+            }, llc);
+            print_row("insert_edge", name, "random-weights", m, bytes, m, ns, llc);
+
+            // Vaciado completo: incluye el ordenamiento perezoso de ArraySort
+            ns = measure_ns_per_op(opts.reps, m, fill, [&]() {
+                double acc = 0.0;
+                for (size_t i = 0; i < m; ++i) acc += extractor->extract_min().weight;
+                sink = sink + static_cast<long long>(acc);
+            }, llc);
+            print_row("extract_min", name, "drain", m, bytes, m, ns, llc);
+
+            // Mismo vaciado en lotes de KRUSKAL_DEFAULT_BATCH aristas (lo que usa kruskal())
+            ns = measure_ns_per_op(opts.reps, m, fill, [&]() {
+                std::vector<edge> batch(KRUSKAL_DEFAULT_BATCH);
+                double acc = 0.0;
+                size_t count;
+                while ((count = extractor->extract_batch(batch.data(), batch.size())) > 0) {
+                    for (size_t i = 0; i < count; ++i) acc += batch[i].weight;
+                }
+                sink = sink + static_cast<long long>(acc);
+            }, llc);
+            print_row("extract_batch", name, "drain", m, bytes, m, ns, llc);
+
+            delete extractor;
+        }
+    }
+}
+
+/**
+ * @brief Consultas minimax (arista más pesada del camino u–v en el MST)
+ * Compara el árbol de reconstrucción de Kruskal (LCA O(1)) con recorrer el MST por consulta.
+ */
+void bench_bottleneck(const bench_options& opts)
+{
+    std::mt19937 gen(777);
+    std::uniform_real_distribution<double> distrib(0.0, 1.0);
+
+    for (unsigned int lg = opts.min_log2; lg <= opts.max_log2_uf; lg += 2) {
+        const int n = 1 << lg;
+        std::vector<node> points(n);
+        for (node& p : points) p = {distrib(gen), distrib(gen)};
+        edge_vector edges;
+        generate_spanning_radius_edges(points, 2.0, edges);
+
+        // Costo de construir el árbol dentro de kruskal(), por vértice. La inserción y el
+        // ordenamiento quedan en setup: solo se mide el ciclo de Kruskal, con y sin árbol
+        void* result = nullptr;
+        ArraySort* extractor = nullptr;
+        auto build = [&](bool with_tree) {
+            return measure_ns_per_op(opts.reps, n, [&]() {
+                free_kruskal_result(result);
+                result = nullptr;
+                delete extractor;
+                extractor = new ArraySort();
+                for (const edge& e : edges) extractor->insert_edge(e);
+                extractor->prepare();
+            }, [&]() {
+                result = kruskal(extractor, true, kruskal_options{KRUSKAL_DEFAULT_BATCH, n, with_tree});
+            });
+        };
+        print_row("kruskal", "plain", "radius-edges", n, edges.size() * sizeof(edge), n, build(false));
+        double ns = build(true);
+        const KruskalReconstructionTree* krt = get_reconstruction_tree(result);
+        print_row("kruskal", "reconstruction-tree", "radius-edges", n, krt->memory_bytes(), n, ns);
+        delete extractor;
+
+        const size_t queries = size_t(1) << 20;
+        std::vector<std::pair<int, int>> pairs(queries);
+        for (auto& [u, v] : pairs) { u = gen() % n; v = gen() % n; }
+        ns = measure_ns_per_op(opts.reps, queries, []() {}, [&]() {
+            double acc = 0.0;
+            for (const auto& [u, v] : pairs) acc += krt->bottleneck(u, v);
+            sink = sink + static_cast<long long>(acc);
+        });
+        print_row("bottleneck", "krt-lca", "random-pairs", n, krt->memory_bytes(), queries, ns);
+
+        // Línea base: DFS por el MST desde u hasta v en cada consulta
+        std::vector<std::vector<std::pair<int, double>>> adjacency(n);
+        for (const edge& e : get_mst_edges(result)) {
+            adjacency[e.u].emplace_back(e.v, e.weight);
+            adjacency[e.v].emplace_back(e.u, e.weight);
+        }
+        const size_t walks = 64;
+        std::vector<double> best(n);
+        std::vector<int> stack;
+        ns = measure_ns_per_op(opts.reps, walks, []() {}, [&]() {
+            double acc = 0.0;
+            for (size_t q = 0; q < walks; ++q) {
+                auto [u, v] = pairs[q];
+                std::fill(best.begin(), best.end(), -1.0);
+                best[u] = 0.0;
+                stack.assign(1, u);
+                while (!stack.empty() && best[v] < 0) {
+                    int x = stack.back();
+                    stack.pop_back();
+                    for (const auto& [y, w] : adjacency[x]) {
+                        if (best[y] < 0) {
+                            best[y] = std::max(best[x], w);
+                            stack.push_back(y);
+                        }
+                    }
+                }
+                acc += best[v];
+            }
+            sink = sink + static_cast<long long>(acc);
+        });
+        print_row("bottleneck", "mst-walk", "random-pairs", n, (n - 1) * sizeof(edge), walks, ns);
+
+        free_kruskal_result(result);
+    }
+}
+
+void print_usage(const char* prog)
+{
+    std::cerr << "Uso: " << prog << " [--min-log2 10] [--max-log2-uf 22] [--max-log2-edges 22] [--reps 5]" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    bench_options opts;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        unsigned int value;
+        try {
+            value = std::stoul(argv[i + 1]);
+        } catch (const std::exception&) {
+            std::cerr << "Error: valor inválido para " << key << ": '" << argv[i + 1] << "'" << std::endl;
+            print_usage(argv[0]);
+            return 2;
+        }
+        if (key == "--min-log2") opts.min_log2 = value;
+        else if (key == "--max-log2-uf") opts.max_log2_uf = value;
+        else if (key == "--max-log2-edges") opts.max_log2_edges = value;
+        else if (key == "--reps") opts.reps = value;
+        else {
+            std::cerr << "Opción desconocida: " << key << std::endl;
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::cout << "Primitive,Variant,Pattern,Size,Bytes,Ops,NsPerOp,LLCMissesPerOp" << std::endl;
+    bench_union_find(opts);
+    bench_extractors(opts);
+    bench_bottleneck(opts);
+    return 0;
+}
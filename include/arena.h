@@ -0,0 +1,156 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mem_tracker.h"
+
+/**
+ * @brief Origen de la memoria de los arreglos de aristas
+ */
+enum class arena_mode
+{
+    system, ///< operator new/delete (comportamiento original)
+    arena,  ///< Arena por hilo reutilizada entre trabajos
+    huge    ///< Arena por hilo sobre páginas de 2 MB (MAP_HUGETLB o madvise)
+};
+
+/**
+ * @brief Arena de memoria de un hilo, reutilizada entre trabajos
+ * Asigna por bump-pointer sobre bloques obtenidos con mmap. Liberar no devuelve
+ * memoria al sistema: cuando ya no queda ninguna asignación viva (al terminar un
+ * trabajo) la arena vuelve al inicio y el siguiente trabajo reutiliza las mismas
+ * páginas, que ya están mapeadas. Así los page faults y fallos de TLB de los
+ * arreglos de varios GB se pagan una vez por hilo y no en cada inserción.
+ * No es segura entre hilos: cada hilo usa la suya (thread_arena()).
+ */
+class Arena
+{
+private:
+    struct chunk
+    {
+        char* base;      ///< Inicio del bloque mapeado
+        size_t capacity; ///< Bytes del bloque
+        size_t used;     ///< Bytes ocupados desde base
+    };
+
+    std::vector<chunk> chunks;
+    size_t live = 0;                ///< Asignaciones sin liberar
+    alloc_snapshot counters = {};   ///< Asignaciones y bytes servidos por la arena (no pasan por operator new)
+    arena_mode mode = arena_mode::system;
+    bool prefault = false;
+
+    chunk map_chunk(size_t bytes);
+    void unmap_chunk(const chunk& c);
+    void rewind();
+
+public:
+    static constexpr size_t HUGE_PAGE_BYTES = size_t(2) << 20;   ///< 2 MB
+    static constexpr size_t MIN_CHUNK_BYTES = size_t(64) << 20;  ///< Tamaño mínimo de un bloque
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Configura el origen de la memoria (llamar sin asignaciones vivas)
+     * @param mode Modo de asignación
+     * @param prefault Si tocar todas las páginas de un bloque nuevo al mapearlo
+     */
+    void configure(arena_mode mode, bool prefault);
+
+    /**
+     * @brief Indica si la arena está activa (modo distinto de system)
+     */
+    bool enabled() const { return mode != arena_mode::system; }
+
+    /**
+     * @brief Asigna memoria de la arena
+     * @param bytes Tamaño solicitado
+     * @param align Alineamiento requerido
+     * @return Puntero a la memoria
+     */
+    void* allocate(size_t bytes, size_t align);
+
+    /**
+     * @brief Libera memoria si pertenece a esta arena
+     * @param ptr Puntero retornado por allocate()
+     * @param bytes Tamaño con que se asignó
+     * @return false si ptr no pertenece a la arena
+     */
+    bool deallocate(void* ptr, size_t bytes);
+
+    /**
+     * @brief Bytes mapeados por la arena (reservados, no necesariamente en uso)
+     */
+    size_t mapped_bytes() const;
+
+    /**
+     * @brief Contadores de lo servido por la arena, con el mismo significado que thread_allocations()
+     * La memoria de la arena sale de mmap y no pasa por el operator new que cuenta
+     * mem_tracker, así que las columnas de memoria deben sumar ambos.
+     */
+    alloc_snapshot allocations() const { return counters; }
+
+    /**
+     * @brief Reinicia el máximo de bytes vivos de la arena al valor actual
+     */
+    void reset_peak() { counters.peak_live_bytes = counters.live_bytes; }
+
+    ~Arena();
+};
+
+/**
+ * @brief Arena del hilo actual
+ */
+Arena& thread_arena();
+
+/**
+ * @brief Convierte el nombre de un modo ("system", "arena", "huge")
+ * @param name Nombre del modo
+ * @param mode Modo resultante
+ * @return false si el nombre no existe
+ */
+bool parse_arena_mode(const std::string& name, arena_mode& mode);
+
+/**
+ * @brief Allocator STL que usa la arena del hilo si está activa y operator new si no
+ * Guarda la arena en la que se construyó: la memoria vuelve siempre a esa arena,
+ * aunque el vector se libere en otro hilo (que no debe coincidir con asignaciones
+ * del dueño, ya que la arena no está sincronizada). Las copias de vectores (p.ej.
+ * clone()) comparten la arena del original.
+ */
+template <typename T>
+struct EdgeAllocator
+{
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    Arena* arena; ///< Arena dueña de la memoria (nullptr = operator new)
+
+    EdgeAllocator() noexcept : arena(thread_arena().enabled() ? &thread_arena() : nullptr) {}
+    template <typename U>
+    EdgeAllocator(const EdgeAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(size_t n)
+    {
+        if (arena) return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        if (arena) arena->deallocate(ptr, n * sizeof(T));
+        else ::operator delete(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const EdgeAllocator<U>& other) const noexcept { return arena == other.arena; }
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef ASYNC_WRITER_H
+#define ASYNC_WRITER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Archivo de destino de un registro
+ */
+enum class write_target : unsigned char
+{
+    logs = 0,
+    df = 1
+};
+
+/**
+ * @brief Escritor asíncrono de logs y filas CSV
+ * Cada hilo productor tiene su propio ring buffer SPSC (un productor, un
+ * consumidor) sin locks, con registros de texto ya formateado. Un hilo de fondo
+ * vacía los rings y hace la E/S, así que los workers nunca esperan al disco ni
+ * compiten por un mutex; solo esperan (cediendo la CPU) si su ring se llena.
+ * Los mensajes de un mismo hilo salen en orden y nunca se intercalan con otros.
+ */
+class AsyncWriter
+{
+public:
+    static constexpr size_t RECORD_BYTES = 256;     ///< Tamaño de un registro del ring
+    static constexpr size_t RING_RECORDS = 1024;    ///< Registros por ring (potencia de 2)
+    static constexpr size_t MAX_RECORDS_PER_MESSAGE = 16; ///< Mensajes más largos se truncan
+
+    /**
+     * @brief Registro de tamaño fijo; un mensaje largo ocupa varios registros consecutivos
+     */
+    struct record
+    {
+        write_target target;
+        unsigned short length;  ///< Bytes usados de text
+        char text[RECORD_BYTES - 4];
+    };
+
+    /**
+     * @brief Ring buffer SPSC de un hilo productor
+     */
+    struct ring
+    {
+        alignas(64) std::atomic<size_t> head = 0; ///< Próximo registro a escribir (productor)
+        alignas(64) std::atomic<size_t> tail = 0; ///< Próximo registro a leer (consumidor)
+        record records[RING_RECORDS];
+    };
+
+private:
+    std::ostream& df;
+    std::ostream& logs;
+    std::mutex m_rings;                       ///< Solo protege el registro de rings nuevos
+    std::vector<std::shared_ptr<ring>> rings;
+    std::atomic<bool> running = false;
+    std::thread writer_thread;
+
+    ring& current_ring();
+    size_t drain();
+    void run();
+
+public:
+    /**
+     * @brief Construye el escritor sobre los streams de destino
+     * @param df Stream del CSV de resultados
+     * @param logs Stream de logs
+     */
+    AsyncWriter(std::ostream& df, std::ostream& logs);
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    /**
+     * @brief Lanza el hilo de fondo que vacía los rings
+     */
+    void start();
+
+    /**
+     * @brief Vacía todo lo pendiente, detiene el hilo de fondo y hace flush
+     * Llamar cuando los productores ya terminaron.
+     */
+    void stop();
+
+    /**
+     * @brief Encola un mensaje ya formateado (no bloquea por E/S)
+     * @param target Archivo de destino
+     * @param text Texto a escribir tal cual (incluyendo el salto de línea si corresponde)
+     */
+    void write(write_target target, std::string_view text);
+
+    ~AsyncWriter();
+};
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef AUTO_EXTRACTOR_H
+#define AUTO_EXTRACTOR_H
+
+#include <string>
+#include <vector>
+
+#include "edge_extractor.h"
+
+/**
+ * @brief Nombre con que se pide el extractor automático (--extractors Auto)
+ */
+inline const std::string AUTO_EXTRACTOR_NAME = "Auto";
+
+/**
+ * @brief Costo calibrado de un extractor, en nanosegundos
+ * Con lg = log2(m), el costo de insertar m aristas y extraer k es:
+ *   m·(insert_base + insert_log·lg) + prepare·m·lg + k·(extract_base + extract_log·lg)
+ */
+struct extractor_cost
+{
+    std::string name;      ///< Nombre del extractor (get_name())
+    double insert_base;    ///< ns por arista insertada, término constante
+    double insert_log;     ///< ns por arista insertada, término en log2(m)
+    double prepare;        ///< ns por m·log2(m) del ordenamiento/heapify con un hilo
+    double extract_base;   ///< ns por arista extraída, término constante
+    double extract_log;    ///< ns por arista extraída, término en log2(m)
+    double bytes_per_edge; ///< Memoria retenida por arista
+    bool parallel;         ///< Si prepare() reparte el trabajo entre hilos
+};
+
+/**
+ * @brief Modelo de costo: un extractor_cost por extractor candidato
+ */
+struct cost_model
+{
+    std::vector<extractor_cost> extractors;
+};
+
+/**
+ * @brief Datos del trabajo que usa el modelo para elegir el extractor
+ */
+struct extraction_hint
+{
+    size_t num_edges = 0;           ///< m: aristas que se insertarán
+    double consumed_fraction = 1.0; ///< Fracción esperada de aristas que extraerá Kruskal
+    size_t available_bytes = 0;     ///< Memoria disponible (0 = leerla de /proc/meminfo)
+    unsigned int threads = 1;       ///< Hilos disponibles para extractores paralelos
+};
+
+/**
+ * @brief Fracción esperada de aristas que consume Kruskal
+ * Para puntos uniformes el MST termina cerca de las n·ln(n) aristas más cortas.
+ * @param num_nodes Número de vértices
+ * @param num_edges Número de aristas
+ * @return Fracción en (0, 1]
+ */
+double estimate_consumed_fraction(size_t num_nodes, size_t num_edges);
+
+/**
+ * @brief Memoria disponible del sistema (MemAvailable de /proc/meminfo)
+ * @return Bytes, o 0 si no se pudo leer
+ */
+size_t available_memory_bytes();
+
+/**
+ * @brief Costo estimado de un extractor para un trabajo
+ * @param cost Coeficientes calibrados
+ * @param hint Datos del trabajo
+ * @return Nanosegundos estimados (inserción + preparación + extracción)
+ */
+double predict_cost_ns(const extractor_cost& cost, const extraction_hint& hint);
+
+/**
+ * @brief Elige el extractor de menor costo estimado que cabe en memoria
+ * Si ninguno cabe, elige el de menor memoria.
+ * @param model Modelo calibrado
+ * @param hint Datos del trabajo
+ * @return Nombre del extractor elegido
+ */
+std::string choose_extractor(const cost_model& model, const extraction_hint& hint);
+
+/**
+ * @brief Mide cada extractor candidato y ajusta sus coeficientes por mínimos cuadrados
+ * @param max_log2_edges Mayor tamaño de calibración (log2 de aristas)
+ * @return Modelo calibrado
+ */
+cost_model calibrate_cost_model(unsigned int max_log2_edges = 20);
+
+/**
+ * @brief Lee un modelo guardado con save_cost_model()
+ * @param path Ruta del archivo
+ * @param model Modelo resultante
+ * @return false si el archivo no existe, es inválido o le falta algún candidato actual
+ */
+bool load_cost_model(const std::string& path, cost_model& model);
+
+/**
+ * @brief Guarda el modelo como CSV
+ * @param path Ruta del archivo
+ * @param model Modelo a guardar
+ * @return true si se pudo escribir
+ */
+bool save_cost_model(const std::string& path, const cost_model& model);
+
+/**
+ * @brief Modelo compartido por el proceso: se lee del caché o se calibra y guarda una vez
+ * Es seguro llamarlo desde varios hilos; solo la primera llamada usa path.
+ * @param path Archivo de caché del modelo
+ * @return Modelo calibrado
+ */
+const cost_model& shared_cost_model(const std::string& path);
+
+/**
+ * @brief Crea un extractor por nombre, incluyendo "Auto"
+ * @param name Nombre del extractor
+ * @param hint Datos del trabajo (los usan "Auto" y "RunMerge", que toma hint.threads)
+ * @param model_path Caché del modelo de costo (solo lo usa "Auto")
+ * @return Puntero a nueva instancia, o nullptr si el nombre no existe
+ */
+EdgeExtractor* make_edge_extractor(const std::string& name, const extraction_hint& hint, const std::string& model_path);
+
+/**
+ * @brief Extractor que delega en el que el modelo de costo estima más rápido
+ * La elección ocurre una vez, al construirlo; get_name() la informa como "Auto(ArraySort)".
+ */
+class AutoExtractor : public EdgeExtractor
+{
+private:
+    EdgeExtractor* inner; ///< Extractor elegido
+
+    explicit AutoExtractor(EdgeExtractor* inner) : inner(inner) {}
+
+public:
+    /**
+     * @brief Elige y construye el extractor para un trabajo
+     * @param model Modelo calibrado
+     * @param hint Datos del trabajo
+     */
+    AutoExtractor(const cost_model& model, const extraction_hint& hint)
+        : inner(make_edge_extractor(choose_extractor(model, hint), hint, "")) {}
+
+    void insert_edge(const edge& e) override { inner->insert_edge(e); }
+    edge extract_min() override { return inner->extract_min(); }
+    size_t extract_batch(edge* out, size_t k) override { return inner->extract_batch(out, k); }
+    void prepare() override { inner->prepare(); }
+    void reserve(size_t n) override { inner->reserve(n); }
+    void clear() override { inner->clear(); }
+    const std::string get_name() override { return AUTO_EXTRACTOR_NAME + "(" + inner->get_name() + ")"; }
+    unsigned int size() override { return inner->size(); }
+    AutoExtractor* clone() override { return new AutoExtractor(inner->clone()); }
+
+    ~AutoExtractor() { delete inner; }
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef BATCH_MST_H
+#define BATCH_MST_H
+
+#include <cstddef>
+#include <vector>
+
+#include "utils.h"
+#include "edge_extractor.h"
+#include "edge_generation.h"
+#include "metric.h"
+
+/**
+ * @brief Lote de instancias de MST independientes en almacenamiento plano
+ * Todas las aristas del lote viven en un único arreglo (con la arena del hilo si
+ * está activa) y cada instancia es un rango de él, de modo que agregar miles de
+ * instancias chicas no crea un extractor, un Union-Find ni un resultado por cada una.
+ * Los vértices de cada instancia se numeran desde 0.
+ */
+class MSTBatch
+{
+    edge_vector edges;                ///< Aristas de todas las instancias, una tras otra
+    std::vector<size_t> first_edge;   ///< first_edge[i]..first_edge[i+1]: aristas de la instancia i
+    std::vector<int> nodes;           ///< Vértices de cada instancia
+
+    /**
+     * @brief Asegura capacidad para extra aristas más, creciendo de forma geométrica
+     */
+    void grow_for(size_t extra);
+
+public:
+    MSTBatch() : first_edge{0} {}
+
+    /**
+     * @brief Agrega una instancia dada por sus aristas
+     * @param num_nodes Vértices de la instancia
+     * @param begin Primera arista
+     * @param count Número de aristas (pesos no negativos)
+     */
+    void add_instance(int num_nodes, const edge* begin, size_t count);
+
+    /**
+     * @brief Agrega una instancia de grafo completo sobre puntos del plano
+     * Los pesos son los de generate_complete_edges<Metric>() (por omisión, distancias al cuadrado).
+     * @tparam Metric Política de métrica
+     * @param points Puntos de la instancia
+     */
+    template <metric_policy Metric = squared_l2>
+    void add_points(const std::vector<node>& points)
+    {
+        grow_for(points.size() * (points.size() - 1) / 2);
+        generate_complete_edges<Metric>(points, edges);
+        first_edge.push_back(edges.size());
+        nodes.push_back(static_cast<int>(points.size()));
+    }
+
+    /**
+     * @brief Reserva espacio para el total de instancias y aristas del lote
+     */
+    void reserve(size_t instances, size_t total_edges);
+
+    /**
+     * @brief Vacía el lote conservando la memoria reservada
+     */
+    void clear();
+
+    size_t size() const { return nodes.size(); }
+    size_t total_edges() const { return edges.size(); }
+    int num_nodes(size_t i) const { return nodes[i]; }
+    const edge* instance_edges(size_t i) const { return edges.data() + first_edge[i]; }
+    size_t instance_edge_count(size_t i) const { return first_edge[i + 1] - first_edge[i]; }
+};
+
+/**
+ * @brief MST de todas las instancias de un lote
+ * Las aristas de la instancia i están en mst_edges[first_mst_edge[i]] ..
+ * mst_edges[first_mst_edge[i] + mst_size[i]]; si la instancia no es conexa,
+ * mst_size[i] < num_nodes - 1 (bosque).
+ */
+struct mst_batch_result
+{
+    std::vector<double> weight;          ///< Peso total del MST de cada instancia
+    std::vector<size_t> first_mst_edge;  ///< Inicio de las aristas de cada instancia en mst_edges
+    std::vector<int> mst_size;           ///< Aristas del MST de cada instancia
+    std::vector<edge> mst_edges;         ///< Aristas de todos los MST
+};
+
+/**
+ * @brief Resuelve todas las instancias del lote
+ * Cada hilo toma grupos de instancias de un contador atómico y las resuelve sin
+ * despacho virtual, reutilizando entre instancias sus buffers de ordenamiento
+ * (pares peso/índice con el kernel activo de ArraySort) y su Union-Find. Cada
+ * instancia escribe en su propio rango del resultado, sin sincronización.
+ * @param batch Lote de instancias
+ * @param opti_path Si usar path compression en el Union-Find
+ * @param threads Hilos de trabajo (0 = hardware_concurrency)
+ * @return Peso y aristas del MST de cada instancia
+ */
+mst_batch_result solve_mst_batch(const MSTBatch& batch, bool opti_path, unsigned int threads = 1);
+
+#endif
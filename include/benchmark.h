@@ -0,0 +1,66 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+
+/**
+ * @brief Una medición del modo benchmark
+ */
+struct bench_sample
+{
+    datapoint data;    ///< Tiempos medidos y configuración del experimento
+    unsigned int rep;  ///< Repetición (conjunto de puntos) de la que proviene
+    unsigned int run;  ///< Índice de la corrida sobre la misma entrada
+    bool warmup;       ///< Si es una corrida de calentamiento (no entra en las estadísticas)
+};
+
+/**
+ * @brief Número de CPUs en el conjunto permitido al proceso (al menos 1)
+ */
+unsigned int available_cpus();
+
+/**
+ * @brief Fija el hilo actual a un bloque de CPUs
+ * El worker i recibe las CPUs [i·cpus_per_worker, (i+1)·cpus_per_worker) del conjunto
+ * permitido al proceso (en round-robin), de modo que siempre corre en las mismas.
+ * Los hilos que lance (p.ej. los de RunMerge::prepare()) heredan el bloque completo.
+ * @param worker_id Índice del worker
+ * @param cpus_per_worker CPUs reservadas a cada worker
+ * @return true si se pudo fijar la afinidad
+ */
+bool pin_current_thread(unsigned int worker_id, unsigned int cpus_per_worker = 1);
+
+/**
+ * @brief Acumula las mediciones del modo benchmark y escribe sus resúmenes
+ * Es seguro llamar a add() desde varios hilos.
+ */
+class BenchRecorder
+{
+private:
+    std::mutex m_samples;
+    std::vector<bench_sample> samples;
+
+public:
+    /**
+     * @brief Registra una medición
+     * @param sample Medición a registrar
+     */
+    void add(const bench_sample& sample);
+
+    /**
+     * @brief Escribe las corridas individuales y el resumen por configuración
+     * Las corridas se marcan como outlier por grupo (N, extractor, opti_path, k);
+     * el resumen tiene mediana, MAD e IC 95% de TimeInsertion y TimeKruskal.
+     * @param runs_path CSV con todas las corridas (incluye calentamiento)
+     * @param summary_path CSV con una fila por (N, extractor, opti_path, k, métrica)
+     * @param with_clusters Agregar la columna Clusters (modo k-clustering)
+     * @return true si ambos archivos se escribieron
+     */
+    bool write(const std::string& runs_path, const std::string& summary_path, bool with_clusters = false);
+};
+
+#endif
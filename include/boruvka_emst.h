@@ -0,0 +1,47 @@
+#ifndef BORUVKA_EMST_H
+#define BORUVKA_EMST_H
+
+#include <cstddef>
+#include <vector>
+
+#include "utils.h"
+#include "metric.h"
+#include "point_set.h"
+
+/**
+ * @brief Mayor dimensión instanciada de dual_tree_boruvka() (se instancian 2..EMST_MAX_DIMENSION)
+ */
+constexpr size_t EMST_MAX_DIMENSION = 16;
+
+/**
+ * @brief Resultado de dual_tree_boruvka()
+ */
+struct emst_result
+{
+    double weight = 0.0;                           ///< Peso total del árbol (en la métrica usada)
+    std::vector<edge> edges;                       ///< n - 1 aristas, con los índices originales de los puntos
+    unsigned int rounds = 0;                       ///< Rondas de Borůvka
+    unsigned long long distance_evaluations = 0;   ///< Pesos punto a punto calculados
+    unsigned long long node_pairs = 0;             ///< Pares de nodos del kd-tree visitados
+    unsigned long long pruned_pairs = 0;           ///< Pares descartados por cota o por componente común
+};
+
+/**
+ * @brief MST geométrico por Borůvka dual-tree sobre un kd-tree (March, Ram y Gray, 2010)
+ * Nunca materializa las n(n-1)/2 aristas: en cada ronda, un recorrido simultáneo
+ * del kd-tree contra sí mismo busca la arista más liviana que sale de cada componente,
+ * descartando pares de nodos cuya cota inferior (separación de sus cajas) supera la
+ * mejor candidata de todas las componentes del nodo consultado, o cuyos puntos ya están
+ * en una misma componente. Los empates se rompen por los índices de los extremos,
+ * así que el árbol coincide con el de Kruskal sobre el grafo completo.
+ * Con squared_l2 el árbol es el MST euclidiano y su peso es la suma de distancias al cuadrado.
+ * Memoria O(n); instanciado para D = 2..EMST_MAX_DIMENSION y las tres métricas de metric.h.
+ * @tparam D Dimensión
+ * @tparam Metric Métrica definida por coordenada
+ * @param points Puntos
+ * @return Aristas del árbol y contadores del recorrido
+ */
+template <size_t D, coordinate_metric Metric = squared_l2>
+emst_result dual_tree_boruvka(const PointSet<D>& points);
+
+#endif
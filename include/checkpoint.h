@@ -0,0 +1,79 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "utils.h"
+
+/**
+ * @brief Nombre de la columna de df.csv con la semilla del trabajo (solo con --resume 1)
+ */
+inline const std::string SEED_COLUMN = "Seed";
+
+/**
+ * @brief Nombre de la columna de df.csv con config_fingerprint() (solo con --resume 1)
+ */
+inline const std::string CONFIG_COLUMN = "Config";
+
+/**
+ * @brief Combinaciones ya completadas de un barrido, leídas de un df.csv previo
+ * Una fila de df.csv se escribe completa solo cuando su experimento terminó, así
+ * que el propio CSV sirve de checkpoint: cada fila marca como hecha la combinación
+ * (N, semilla, extractor, opti_path, k). El resto de la configuración que afecta
+ * las mediciones va en la columna Config y debe ser igual en todo el archivo.
+ */
+class SweepCheckpoint
+{
+    using key = std::tuple<unsigned long long, unsigned int, std::string, bool, unsigned int>;
+    std::set<key> completed;
+
+public:
+    /**
+     * @brief Lee las filas de un df.csv escrito con --resume 1
+     * Si la última línea quedó a medias (el proceso murió escribiéndola), el
+     * archivo se trunca al último salto de línea. Un archivo inexistente o vacío
+     * es un barrido sin filas.
+     * @param path Ruta de df.csv
+     * @param header Encabezado que tendría un df.csv nuevo con la configuración actual
+     * @param fingerprint config_fingerprint() de la configuración actual
+     * @param error Motivo si el archivo no se puede continuar
+     * @return false si el encabezado o la configuración de alguna fila no coinciden,
+     *         o si el archivo no se puede leer
+     */
+    bool load(const std::string& path, const std::string& header, const std::string& fingerprint, std::string& error);
+
+    /**
+     * @brief Indica si una combinación ya tiene su fila en df.csv
+     * @param extractor Nombre del extractor en la configuración (Auto coincide con "Auto(...)")
+     * @param clusters k del modo k-clustering (0 = MST completo)
+     */
+    bool done(unsigned long long n, unsigned int seed, const std::string& extractor, bool opti_path, unsigned int clusters) const;
+
+    /**
+     * @brief Filas leídas del archivo
+     */
+    size_t size() const { return completed.size(); }
+};
+
+/**
+ * @brief Lee los puntos de un trabajo desde la caché de entradas
+ * @param dir Directorio de la caché
+ * @param log2_n Tamaño del trabajo (log2 N)
+ * @param seed Semilla del trabajo
+ * @param nodes Puntos leídos
+ * @return false si no hay un archivo completo para (N, semilla)
+ */
+bool load_cached_points(const std::string& dir, unsigned int log2_n, unsigned int seed, std::vector<node>& nodes);
+
+/**
+ * @brief Guarda los puntos de un trabajo en la caché de entradas
+ * Se escribe a un archivo temporal que luego se renombra, así que un archivo de
+ * la caché nunca queda a medias.
+ * @return false si no se pudo escribir
+ */
+bool store_cached_points(const std::string& dir, unsigned int log2_n, unsigned int seed, const std::vector<node>& nodes);
+
+#endif
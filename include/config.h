@@ -0,0 +1,103 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <string>
+#include <vector>
+
+#include "arena.h"
+#include "spatial_order.h"
+#include "edge_generation.h"
+#include "metric.h"
+#include "simd_sort.h"
+
+/**
+ * @brief Configuración de un barrido de experimentos
+ * Reemplaza las constantes que antes estaban fijas en main.cpp, de modo que un
+ * mismo binario pueda ejecutar estudios distintos sin recompilar.
+ */
+struct experiment_config
+{
+    unsigned int log2_n_init = 5;                          ///< Primer tamaño del barrido (log2 N)
+    unsigned int log2_n_end = 14;                          ///< Último tamaño del barrido (log2 N, inclusivo)
+    unsigned int repetitions = 5;                          ///< Secuencias (conjuntos de puntos) por tamaño
+    unsigned int seed = 1234;                              ///< Semilla base del barrido
+    unsigned int max_threads = 1;                          ///< Número máximo de hilos de trabajo
+    std::vector<std::string> extractors = {"ArraySort", "HeapMin", "RunMerge", "SequenceHeap"}; ///< Extractores a evaluar
+    std::vector<bool> opti_paths = {true, false};          ///< Políticas de Union-Find (path compression)
+    std::string df_path = "resultados/df.csv";             ///< Archivo CSV de resultados
+    std::string logs_path = "resultados/logs.txt";         ///< Archivo de logs
+    bool perf_counters = false;                            ///< Registrar contadores de hardware por fase en df.csv
+    bool memory_tracking = false;                          ///< Registrar memoria (RSS máximo y asignaciones) en df.csv
+    std::string cost_model_path = "resultados/cost_model.csv"; ///< Caché del modelo de costo del extractor Auto
+    std::string trace_path;                                ///< Traza Chrome trace-event de las fases por hilo (vacío = desactivada)
+    arena_mode allocator = arena_mode::system;             ///< Origen de la memoria de los arreglos de aristas
+    bool prefault = false;                                 ///< Tocar las páginas de la arena al mapearlas
+    vertex_order order = vertex_order::generation;         ///< Numeración de los vértices antes de generar aristas
+    edge_mode edges = edge_mode::complete;                 ///< Aristas generadas: todos los pares o acotadas por radio
+    double radius_c = 2.0;                                 ///< Constante c del umbral inicial c·ln(n)/n en modo radius
+    metric_kind metric = metric_kind::sqeuclidean;         ///< Métrica de los pesos de las aristas
+    sort_kernel array_sort = sort_kernel::automatic;       ///< Ordenamiento de ArraySort (std = aristas completas)
+    unsigned int kruskal_batch = 64;                       ///< Aristas por extract_batch() en Kruskal (1 = una a una)
+    bool reconstruction_tree = false;                      ///< Construir en Kruskal el árbol de reconstrucción e índice LCA
+    std::vector<unsigned int> clusters;                    ///< Valores de k del modo k-clustering (vacío = MST completo)
+    bool resume = false;                                   ///< Continuar un df.csv previo saltando las combinaciones hechas
+    std::string input_cache;                               ///< Directorio de caché de los puntos generados (vacío = sin caché)
+    std::string serve;                                     ///< Modo servicio: "stdin" o "unix:RUTA" (vacío = barrido)
+
+    // Modo benchmark: varias corridas sobre la misma entrada y resumen estadístico
+    bool bench_mode = false;                               ///< Activa el modo benchmark
+    unsigned int warmup_runs = 2;                          ///< Corridas de calentamiento descartadas
+    unsigned int measure_runs = 10;                        ///< Corridas medidas por entrada
+    int pin_threads = -1;                                  ///< Fijar workers a CPUs: 1 sí, 0 no, -1 solo en modo benchmark
+    std::string bench_runs_path = "resultados/bench_runs.csv";       ///< CSV con cada corrida del benchmark
+    std::string bench_summary_path = "resultados/bench_summary.csv"; ///< CSV con mediana/MAD/IC por configuración
+};
+
+/**
+ * @brief Lee la configuración desde la línea de comandos
+ * Las opciones se aplican en orden, por lo que una opción posterior sobrescribe
+ * a un archivo cargado antes con --config.
+ * @param argc Número de argumentos
+ * @param argv Argumentos del programa
+ * @param config Configuración a completar (parte de los valores por defecto)
+ * @return true si la configuración es válida y se debe ejecutar el barrido
+ */
+bool parse_config(int argc, char** argv, experiment_config& config);
+
+/**
+ * @brief Carga un archivo de configuración con líneas "clave = valor"
+ * Las claves son los nombres largos de las opciones sin "--" (p.ej. "threads = 16").
+ * Las líneas vacías y las que comienzan con '#' se ignoran.
+ * @param path Ruta del archivo
+ * @param config Configuración a completar
+ * @return true si el archivo se pudo leer y todas sus claves son válidas
+ */
+bool load_config_file(const std::string& path, experiment_config& config);
+
+/**
+ * @brief Imprime la ayuda de las opciones disponibles
+ * @param prog Nombre del ejecutable
+ */
+void print_usage(const char* prog);
+
+/**
+ * @brief Calcula la semilla de un trabajo del barrido
+ * Depende solo de (semilla base, tamaño, repetición), así que los puntos
+ * generados son los mismos sin importar el número de hilos ni el orden de ejecución.
+ * @param config Configuración del barrido
+ * @param log2_n Tamaño del trabajo (log2 N)
+ * @param rep Índice de la repetición
+ * @return Semilla para el generador del trabajo
+ */
+unsigned int job_seed(const experiment_config& config, unsigned int log2_n, unsigned int rep);
+
+/**
+ * @brief Opciones que cambian lo que mide una fila de df.csv sin cambiar sus columnas
+ * Con --resume 1 se guarda en cada fila; un barrido solo se reanuda con la misma
+ * métrica, aristas, numeración, kernel de ordenamiento, asignador, lote de Kruskal
+ * y árbol de reconstrucción.
+ * @return Texto "clave=valor;..." sin comas
+ */
+std::string config_fingerprint(const experiment_config& config);
+
+#endif
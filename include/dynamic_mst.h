@@ -0,0 +1,188 @@
+#ifndef DYNAMIC_MST_H
+#define DYNAMIC_MST_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "utils.h"
+
+/**
+ * @brief Árbol link-cut sobre un arreglo de nodos, con máximo de peso por camino
+ * Cada vértice y cada arista del bosque es un nodo; los vértices pesan -inf, así
+ * que el máximo de un camino es siempre su arista más pesada. Operaciones en
+ * O(log n) amortizado.
+ */
+class LinkCutTree
+{
+private:
+    struct lct_node
+    {
+        int child[2] = {-1, -1};
+        int parent = -1;
+        bool reversed = false;
+        double weight = 0.0;
+        int max_node = -1; ///< Nodo de mayor peso en el subárbol splay
+    };
+
+    std::vector<lct_node> nodes;
+
+    bool is_splay_root(int x) const;
+    void pull(int x);
+    void push(int x);
+    void rotate(int x);
+    void splay(int x);
+    void access(int x);
+    void make_root(int x);
+    int find_root(int x);
+
+public:
+    /**
+     * @brief Agrega un nodo aislado
+     * @param weight Peso del nodo (-inf para vértices)
+     * @return Índice del nodo
+     */
+    int add_node(double weight);
+
+    /**
+     * @brief Cambia el peso de un nodo aislado (recién cortado)
+     */
+    void reset_node(int x, double weight);
+
+    /**
+     * @brief Une los árboles de x e y con el enlace x–y (deben estar en árboles distintos)
+     */
+    void link(int x, int y);
+
+    /**
+     * @brief Corta el enlace x–y (deben ser adyacentes)
+     */
+    void cut(int x, int y);
+
+    /**
+     * @brief Indica si x e y están en el mismo árbol
+     */
+    bool connected(int x, int y);
+
+    /**
+     * @brief Nodo de mayor peso en el camino x–y (deben estar conectados)
+     */
+    int path_max(int x, int y);
+
+    /**
+     * @brief Peso de un nodo
+     */
+    double weight(int x) const { return nodes[x].weight; }
+};
+
+/**
+ * @brief Bosque cobertor mínimo que se mantiene bajo inserciones, borrados y cambios de peso
+ * Guarda el grafo completo (aristas del árbol y candidatas). Una arista nueva o
+ * abaratada reemplaza a la más pesada del ciclo que cierra (máximo de camino en
+ * un árbol link-cut, O(log n)). Al sacar una arista del árbol se busca la de
+ * reemplazo recorriendo solo el lado más chico del corte y las aristas que salen
+ * de él, O(tamaño del lado + sus aristas).
+ * Los vértices borrados conservan su id y quedan aislados.
+ */
+class DynamicMST
+{
+private:
+    struct edge_info
+    {
+        double weight;
+        int tree_node; ///< Nodo del árbol link-cut si la arista está en el bosque, -1 si no
+    };
+
+    LinkCutTree forest;
+    std::vector<int> vertex_node;                        ///< Nodo link-cut de cada vértice
+    std::vector<bool> alive;                             ///< Vértices no borrados
+    std::vector<std::unordered_set<int>> adjacency;      ///< Vecinos por cualquier arista
+    std::vector<std::unordered_set<int>> tree_adjacency; ///< Vecinos por aristas del bosque
+    std::unordered_map<uint64_t, edge_info> edges;       ///< Todas las aristas, por par (min, max)
+    std::vector<int> free_edge_nodes;                    ///< Nodos link-cut de aristas reutilizables
+    std::vector<std::pair<int, int>> node_edge;          ///< Arista (u, v) de cada nodo link-cut de arista
+    std::vector<unsigned int> visit_mark;                ///< Marcas para la búsqueda de reemplazo
+    unsigned int visit_stamp = 0;
+    double total_weight = 0.0;
+    size_t tree_edge_count = 0;
+
+    static uint64_t key(int u, int v);
+    void link_tree_edge(int u, int v, edge_info& info);
+    void cut_tree_edge(int u, int v, edge_info& info);
+    void offer(int u, int v, edge_info& info);
+    void find_replacement(int u, int v);
+
+public:
+    /**
+     * @brief Crea un bosque con n vértices aislados
+     * @param n Número inicial de vértices
+     */
+    explicit DynamicMST(int n = 0);
+
+    /**
+     * @brief Agrega un vértice aislado
+     * @return Id del vértice
+     */
+    int add_vertex();
+
+    /**
+     * @brief Agrega un vértice con sus aristas candidatas
+     * @param candidates Pares (vecino, peso)
+     * @return Id del vértice
+     */
+    int insert_vertex(const std::vector<std::pair<int, double>>& candidates);
+
+    /**
+     * @brief Agrega una arista (o cambia su peso si ya existe)
+     */
+    void insert_edge(int u, int v, double weight);
+
+    /**
+     * @brief Cambia el peso de una arista existente
+     */
+    void update_weight(int u, int v, double weight);
+
+    /**
+     * @brief Borra una arista; si era del bosque busca la de reemplazo
+     */
+    void delete_edge(int u, int v);
+
+    /**
+     * @brief Borra un vértice y todas sus aristas
+     */
+    void delete_vertex(int v);
+
+    /**
+     * @brief Indica si hay una arista entre u y v
+     */
+    bool has_edge(int u, int v) const;
+
+    /**
+     * @brief Peso total del bosque cobertor mínimo actual
+     */
+    double weight() const { return total_weight; }
+
+    /**
+     * @brief Número de aristas del bosque actual
+     */
+    size_t tree_size() const { return tree_edge_count; }
+
+    /**
+     * @brief Número de ids de vértice asignados (incluye borrados)
+     */
+    int vertex_count() const { return static_cast<int>(vertex_node.size()); }
+
+    /**
+     * @brief Aristas del bosque actual
+     */
+    std::vector<edge> tree_edges() const;
+
+    /**
+     * @brief Todas las aristas del grafo actual, para recalcular desde cero
+     */
+    std::vector<edge> graph_edges() const;
+};
+
+#endif
@@ -6,8 +6,17 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <limits>
+#include <thread>
 
 #include "utils.h"
+#include "arena.h"
+#include "simd_sort.h"
+
+/**
+ * @brief Vector de aristas cuya memoria sale de la arena del hilo (si está activa)
+ */
+using edge_vector = std::vector<edge, EdgeAllocator<edge>>;
 
 /**
  * @brief Interfaz abstracta para estructuras de extracción de aristas
@@ -27,10 +36,44 @@ public:
      * @return Arista con el menor peso
      */
     virtual edge extract_min() = 0;
+
+    /**
+     * @brief Extrae hasta k aristas en orden de peso creciente
+     * Evita una llamada virtual por arista. La implementación por defecto repite extract_min().
+     * @param out Buffer del llamador con espacio para k aristas
+     * @param k Máximo de aristas a extraer
+     * @return Aristas escritas en out (menos de k solo si la estructura se vació)
+     */
+    virtual size_t extract_batch(edge* out, size_t k)
+    {
+        size_t count = 0;
+        while (count < k && size() > 0) out[count++] = extract_min();
+        return count;
+    }
     
+    /**
+     * @brief Deja la estructura lista para extraer aristas
+     * Permite medir por separado el ordenamiento/heapify de la extracción.
+     * Llamarlo es opcional: extract_min() prepara la estructura si hace falta.
+     */
+    virtual void prepare() {}
+
+    /**
+     * @brief Reserva espacio para n aristas antes de insertarlas
+     * Evita que el arreglo crezca (y se copie) durante la inserción. Opcional.
+     * @param n Número de aristas que se insertarán
+     */
+    virtual void reserve(size_t n) {}
+
+    /**
+     * @brief Vacía la estructura conservando la memoria reservada
+     * Permite reutilizar un mismo extractor entre instancias (modo servicio).
+     */
+    virtual void clear() = 0;
+
     /**
      * @brief Obtiene el nombre de la implementación
-     * @return Nombre del extractor ("HeapMin" o "ArraySort")
+     * @return Nombre del extractor ("HeapMin", "ArraySort", "RunMerge" o "SequenceHeap")
      */
     virtual const std::string get_name() = 0;
     
@@ -65,13 +108,21 @@ private:
         }
     };
     
-    std::priority_queue<edge, std::vector<edge>, EdgeComparator>* min_priority_queue;
+    /**
+     * @brief priority_queue que expone reserve() sobre su contenedor
+     */
+    struct edge_queue : std::priority_queue<edge, edge_vector, EdgeComparator> {
+        void reserve(size_t n) { this->c.reserve(n); }
+        void clear() { this->c.clear(); }
+    };
+
+    edge_queue* min_priority_queue;
 
 public:
     /**
      * @brief Constructor por defecto
      */
-    HeapMin(){min_priority_queue = new std::priority_queue<edge, std::vector<edge>, EdgeComparator>();}
+    HeapMin(){min_priority_queue = new edge_queue();}
 
     /**
      * @brief Constructor de copia
@@ -79,11 +130,15 @@ public:
      */
     HeapMin(const HeapMin &other)
     {
-        min_priority_queue = new std::priority_queue<edge, std::vector<edge>, EdgeComparator>(*other.min_priority_queue);
+        min_priority_queue = new edge_queue(*other.min_priority_queue);
     }
 
     void insert_edge(const edge& e) override { min_priority_queue->push(e); }
 
+    void reserve(size_t n) override { min_priority_queue->reserve(n); }
+
+    void clear() override { min_priority_queue->clear(); }
+
     edge extract_min() override
     {
         edge min_edge = min_priority_queue->top();
@@ -111,19 +166,42 @@ public:
 
 /**
  * @brief Implementación usando array que se ordena al primer extract_min()
- * Almacena aristas en vector y las ordena cuando se necesita extraer el mínimo
+ * Almacena aristas en vector y las ordena cuando se necesita extraer el mínimo.
+ * Salvo con el kernel "std", no mueve las aristas de 16 bytes: ordena pares
+ * (peso, índice de 32 bits) con el kernel de simd_sort.h y sirve las aristas por
+ * índice, así que las que Kruskal no llega a pedir nunca se copian.
  */
 class ArraySort : public EdgeExtractor
 {
 private:
-    std::vector<edge>* array;  ///< Vector que almacena las aristas
+    edge_vector* array;        ///< Vector que almacena las aristas
     bool is_sorted = false;    ///< Flag que indica si el array está ordenado
+    bool by_index = false;     ///< Si el orden está en order (array sin mover) y no en array
+    std::vector<uint32_t> order; ///< Índices de array en orden ascendente de peso (by_index)
+    size_t next = 0;           ///< Próximo elemento de order a extraer (by_index)
+
+    static constexpr size_t KEY_INDEX_MIN_EDGES = 256; ///< Por debajo std::sort sobre las aristas es igual de rápido
+
+    /**
+     * @brief Deja en array solo las aristas no extraídas, sin orden (sale del modo por índice)
+     */
+    void discard_extracted()
+    {
+        edge_vector pending;
+        pending.reserve(order.size() - next);
+        for (size_t i = next; i < order.size(); ++i) pending.push_back((*array)[order[i]]);
+        array->swap(pending);
+        order = std::vector<uint32_t>();
+        next = 0;
+        by_index = false;
+        is_sorted = false;
+    }
 
 public:
     /**
      * @brief Constructor por defecto
      */
-    ArraySort() { array = new std::vector<edge>(); }
+    ArraySort() { array = new edge_vector(); }
 
     /**
      * @brief Constructor de copia
@@ -131,34 +209,95 @@ public:
      */
     ArraySort(const ArraySort &other)
     {
-        array = new std::vector<edge>(*other.array);
+        array = new edge_vector(*other.array);
+        if (other.by_index) {
+            order = other.order;
+            next = other.next;
+            by_index = true;
+            discard_extracted();
+        }
         is_sorted = false; // Reiniciar el flag al clonar
     }
 
     void insert_edge(const edge& e) override
     {
+        if (by_index) discard_extracted();
         array->push_back(e);
         is_sorted = false;
     }
 
-    edge extract_min() override
+    void reserve(size_t n) override { array->reserve(n); }
+
+    void clear() override
+    {
+        array->clear();
+        order.clear();
+        next = 0;
+        by_index = false;
+        is_sorted = false;
+    }
+
+    void prepare() override
     {
         if (!is_sorted)
         {
-            // Ordenar en orden descendente para extraer mínimos desde el final
-            sort(array->begin(), array->end(), [](const edge& a, const edge& b) {
-                return a.weight > b.weight;
-            });
+            const sort_kernel kernel = active_sort_kernel();
+            const size_t m = array->size();
+            if (kernel != sort_kernel::std_sort && m >= KEY_INDEX_MIN_EDGES && m <= std::numeric_limits<uint32_t>::max())
+            {
+                // Ordenar solo (peso, índice) y servir las aristas por índice
+                std::vector<double> keys(m);
+                order.resize(m);
+                for (size_t i = 0; i < m; ++i)
+                {
+                    keys[i] = (*array)[i].weight;
+                    order[i] = static_cast<uint32_t>(i);
+                }
+                sort_key_index(keys, order, kernel);
+                next = 0;
+                by_index = true;
+            }
+            else
+            {
+                // Ordenar en orden descendente para extraer mínimos desde el final
+                sort(array->begin(), array->end(), [](const edge& a, const edge& b) {
+                    return a.weight > b.weight;
+                });
+            }
             is_sorted = true;
         }
+    }
+
+    edge extract_min() override
+    {
+        prepare();
+        if (by_index) return (*array)[order[next++]];
         edge min_edge = array->back();
         array->pop_back();
         return min_edge;
     }
 
+    size_t extract_batch(edge* out, size_t k) override
+    {
+        prepare();
+        if (by_index)
+        {
+            size_t count = std::min(k, order.size() - next);
+            for (size_t i = 0; i < count; ++i) out[i] = (*array)[order[next + i]];
+            next += count;
+            return count;
+        }
+        // Los mínimos están al final del arreglo descendente: se copian en bloque
+        size_t count = std::min(k, array->size());
+        auto last = array->end();
+        for (size_t i = 0; i < count; ++i) out[i] = *(last - 1 - i);
+        array->erase(last - count, last);
+        return count;
+    }
+
     const std::string get_name() override { return "ArraySort"; }
 
-    unsigned int size() override { return array->size(); }
+    unsigned int size() override { return by_index ? order.size() - next : array->size(); }
 
     bool operator==(const ArraySort &other) const { 
         if (is_sorted != other.is_sorted){
@@ -182,4 +321,408 @@ public:
     ~ArraySort() { delete array; }
 };
 
+/**
+ * @brief Implementación con corridas ordenadas en paralelo y un árbol de perdedores
+ * prepare() divide el arreglo en una corrida por hilo y ordena cada una en su hilo;
+ * extract_min() sirve el mínimo de las cabezas de las corridas con un árbol de
+ * perdedores (torneo), en O(log k) por arista. No hay mezcla global: si Kruskal
+ * termina antes, las colas de las corridas nunca se recorren.
+ */
+class RunMerge : public EdgeExtractor
+{
+private:
+    /**
+     * @brief Rango [head, end) aún no extraído de una corrida ordenada
+     */
+    struct run
+    {
+        size_t head;
+        size_t end;
+    };
+
+    edge_vector* array;          ///< Aristas; tras prepare(), corridas contiguas en orden ascendente
+    std::vector<run> runs;       ///< Corridas ordenadas (vacío = sin preparar)
+    std::vector<int> tree;       ///< tree[0] = corrida ganadora; tree[1..] = perdedor de cada partido
+    size_t remaining = 0;        ///< Aristas sin extraer
+    unsigned int threads;        ///< Hilos (y corridas) de prepare()
+    size_t min_run;              ///< Tamaño mínimo de una corrida
+
+    double head_weight(int r) const
+    {
+        const run& rr = runs[r];
+        return rr.head < rr.end ? (*array)[rr.head].weight : std::numeric_limits<double>::infinity();
+    }
+
+    /**
+     * @brief Juega los partidos desde la hoja de la corrida r hasta la raíz
+     */
+    void replay(int r)
+    {
+        const size_t leaves = tree.size();
+        int winner = r;
+        for (size_t node = (leaves + r) / 2; node > 0; node /= 2) {
+            if (head_weight(tree[node]) < head_weight(winner)) std::swap(tree[node], winner);
+        }
+        tree[0] = winner;
+    }
+
+    void build_tree()
+    {
+        // Hojas virtuales hasta la potencia de 2; las de relleno son corridas vacías
+        size_t leaves = 1;
+        while (leaves < runs.size()) leaves *= 2;
+        runs.resize(leaves, run{0, 0});
+        tree.assign(leaves, 0);
+        std::vector<int> winners(2 * leaves);
+        for (size_t i = 0; i < leaves; ++i) winners[leaves + i] = static_cast<int>(i);
+        for (size_t node = leaves - 1; node > 0; --node) {
+            int a = winners[2 * node], b = winners[2 * node + 1];
+            bool a_wins = head_weight(a) <= head_weight(b);
+            winners[node] = a_wins ? a : b;
+            tree[node] = a_wins ? b : a;
+        }
+        tree[0] = winners[1];
+    }
+
+    /**
+     * @brief Deja en el arreglo solo las aristas no extraídas y vuelve al estado sin preparar
+     */
+    void discard_extracted()
+    {
+        edge_vector pending;
+        pending.reserve(remaining);
+        for (const run& r : runs) pending.insert(pending.end(), array->begin() + r.head, array->begin() + r.end);
+        array->swap(pending);
+        runs.clear();
+    }
+
+public:
+    static constexpr size_t DEFAULT_MIN_RUN = 1 << 14; ///< Por debajo no compensa lanzar un hilo
+
+    /**
+     * @brief Constructor
+     * @param threads Hilos para ordenar las corridas (0 = núcleos disponibles)
+     * @param min_run Tamaño mínimo de una corrida; con pocas aristas se usan menos hilos
+     */
+    explicit RunMerge(unsigned int threads = 0, size_t min_run = DEFAULT_MIN_RUN)
+        : threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+          min_run(std::max<size_t>(1, min_run))
+    {
+        array = new edge_vector();
+    }
+
+    /**
+     * @brief Constructor de copia
+     * @param other Instancia a copiar
+     */
+    RunMerge(const RunMerge &other)
+        : runs(other.runs), tree(other.tree), remaining(other.remaining),
+          threads(other.threads), min_run(other.min_run)
+    {
+        array = new edge_vector(*other.array);
+    }
+
+    void insert_edge(const edge& e) override
+    {
+        if (!runs.empty()) discard_extracted();
+        array->push_back(e);
+        remaining++;
+    }
+
+    void reserve(size_t n) override { array->reserve(n); }
+
+    void clear() override
+    {
+        array->clear();
+        runs.clear();
+        tree.clear();
+        remaining = 0;
+    }
+
+    void prepare() override
+    {
+        if (!runs.empty()) return;
+        const size_t m = array->size();
+        const size_t k = std::max<size_t>(1, std::min<size_t>(threads, m / min_run));
+        auto by_weight = [](const edge& a, const edge& b) { return a.weight < b.weight; };
+        for (size_t i = 0; i < k; ++i) runs.push_back(run{m * i / k, m * (i + 1) / k});
+
+        // La corrida 0 se ordena en el hilo llamador
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < k; ++i) {
+            workers.emplace_back([this, i, &by_weight]() {
+                std::sort(array->begin() + runs[i].head, array->begin() + runs[i].end, by_weight);
+            });
+        }
+        std::sort(array->begin() + runs[0].head, array->begin() + runs[0].end, by_weight);
+        for (std::thread& t : workers) t.join();
+        build_tree();
+    }
+
+    edge extract_min() override
+    {
+        prepare();
+        const int r = tree[0];
+        edge min_edge = (*array)[runs[r].head++];
+        remaining--;
+        replay(r);
+        return min_edge;
+    }
+
+    size_t extract_batch(edge* out, size_t k) override
+    {
+        prepare();
+        size_t count = std::min(k, remaining);
+        for (size_t i = 0; i < count; ++i) {
+            const int r = tree[0];
+            out[i] = (*array)[runs[r].head++];
+            replay(r);
+        }
+        remaining -= count;
+        return count;
+    }
+
+    const std::string get_name() override { return "RunMerge"; }
+
+    unsigned int size() override { return remaining; }
+
+    bool operator==(const RunMerge &other) const { return remaining == other.remaining; }
+
+    RunMerge *clone() override
+    {
+        RunMerge *new_run_merge = new RunMerge(*this);
+        return new_run_merge;
+    }
+
+    ~RunMerge() { delete array; }
+};
+
+/**
+ * @brief Implementación con un sequence heap (Sanders) amigable con el caché
+ * Las inserciones van a un heap pequeño que cabe en L1; cuando se llena se ordena
+ * y pasa como secuencia ordenada al grupo 0. Cada grupo guarda hasta GROUP_ARITY
+ * secuencias y al llenarse las mezcla (mezcla de k vías) en una sola secuencia del
+ * grupo siguiente. Las extracciones salen de un buffer de borrado que se rellena
+ * mezclando las cabezas de todas las secuencias. Todo el movimiento de aristas es
+ * secuencial, así que los fallos de caché por operación bajan de O(log m) a
+ * O((1/B)·log_k m) frente al heap binario de HeapMin.
+ */
+class SequenceHeap : public EdgeExtractor
+{
+private:
+    /**
+     * @brief Secuencia ordenada (ascendente) con sus primeras head aristas ya consumidas
+     */
+    struct sequence
+    {
+        std::vector<edge> data;
+        size_t head = 0;
+
+        size_t size() const { return data.size() - head; }
+        double head_weight() const
+        {
+            return head < data.size() ? data[head].weight : std::numeric_limits<double>::infinity();
+        }
+    };
+
+    static constexpr size_t INSERT_CAPACITY = 256;  ///< Heap de inserción: 4 KB, cabe en L1
+    static constexpr size_t DELETE_CAPACITY = 1024; ///< Aristas por relleno del buffer de borrado
+    static constexpr size_t GROUP_ARITY = 64;       ///< Secuencias por grupo antes de mezclarlas
+
+    std::vector<edge> insert_heap;                  ///< Min-heap de inserciones recientes
+    std::vector<edge> delete_buffer;                ///< Mínimos de las secuencias, en orden ascendente
+    size_t delete_head = 0;                         ///< Próxima arista del buffer de borrado
+    std::vector<std::vector<sequence>> groups;      ///< groups[i]: secuencias del nivel i
+    size_t sequence_edges = 0;                      ///< Aristas sin consumir en las secuencias
+
+    static bool heap_order(const edge& a, const edge& b) { return a.weight > b.weight; }
+    static bool ascending(const edge& a, const edge& b) { return a.weight < b.weight; }
+
+    /**
+     * @brief Aristas sin extraer (size() sin el requisito de ser no constante)
+     */
+    size_t pending() const { return insert_heap.size() + (delete_buffer.size() - delete_head) + sequence_edges; }
+
+    /**
+     * @brief Agrega a out las count aristas menores de las secuencias, avanzando sus cabezas
+     * Usa un árbol de perdedores sobre las cabezas, que con k <= GROUP_ARITY·niveles
+     * cabe completo en caché; cada secuencia se lee en forma secuencial.
+     * Todas las entradas deben tener en conjunto al menos count aristas.
+     */
+    static void multiway_merge(const std::vector<sequence*>& inputs, std::vector<edge>& out, size_t count)
+    {
+        // Cada nodo guarda el peso de su perdedor junto al índice, así reordenar el
+        // camino de una hoja a la raíz no vuelve a leer las secuencias
+        struct player
+        {
+            double key;
+            int index;
+        };
+        size_t leaves = 1;
+        while (leaves < inputs.size()) leaves *= 2;
+        auto head_of = [&](int i) {
+            return player{static_cast<size_t>(i) < inputs.size() ? inputs[i]->head_weight()
+                                                                 : std::numeric_limits<double>::infinity(), i};
+        };
+        std::vector<player> tree(leaves);
+        std::vector<player> winners(2 * leaves);
+        for (size_t i = 0; i < leaves; ++i) winners[leaves + i] = head_of(static_cast<int>(i));
+        for (size_t node = leaves - 1; node > 0; --node) {
+            const player& a = winners[2 * node];
+            const player& b = winners[2 * node + 1];
+            bool a_wins = a.key <= b.key;
+            winners[node] = a_wins ? a : b;
+            tree[node] = a_wins ? b : a;
+        }
+        player winner = winners[1];
+
+        const size_t start = out.size();
+        out.resize(start + count);
+        edge* dest = out.data() + start;
+        for (size_t n = 0; n < count; ++n) {
+            sequence* seq = inputs[winner.index];
+            dest[n] = seq->data[seq->head++];
+            winner.key = seq->head_weight();
+            // Sin saltos: con pesos aleatorios cada partido es una predicción fallida
+            for (size_t node = (leaves + winner.index) / 2; node > 0; node /= 2) {
+                const player other = tree[node];
+                const bool swap = other.key < winner.key;
+                tree[node].key = swap ? winner.key : other.key;
+                tree[node].index = swap ? winner.index : other.index;
+                winner.key = swap ? other.key : winner.key;
+                winner.index = swap ? other.index : winner.index;
+            }
+        }
+    }
+
+    /**
+     * @brief Agrega una secuencia al nivel level, mezclando el nivel si está lleno
+     */
+    void add_sequence(std::vector<edge>&& data, size_t level)
+    {
+        if (groups.size() <= level) groups.resize(level + 1);
+        std::vector<sequence>& group = groups[level];
+        if (group.size() == GROUP_ARITY) {
+            std::vector<sequence*> inputs;
+            size_t total = 0;
+            for (sequence& seq : group) {
+                inputs.push_back(&seq);
+                total += seq.size();
+            }
+            std::vector<edge> merged;
+            multiway_merge(inputs, merged, total);
+            groups[level].clear();
+            add_sequence(std::move(merged), level + 1);
+        }
+        groups[level].push_back(sequence{std::move(data), 0});
+    }
+
+    /**
+     * @brief Pasa el heap de inserción a una secuencia del grupo 0
+     * Se mezcla antes con lo que queda del buffer de borrado para mantener que toda
+     * arista de una secuencia sea mayor o igual que las del buffer.
+     */
+    void flush_insert_heap()
+    {
+        std::sort(insert_heap.begin(), insert_heap.end(), ascending);
+        const size_t pending = delete_buffer.size() - delete_head;
+        std::vector<edge> merged(pending + insert_heap.size());
+        std::merge(delete_buffer.begin() + delete_head, delete_buffer.end(),
+                   insert_heap.begin(), insert_heap.end(), merged.begin(), ascending);
+        delete_buffer.assign(merged.begin(), merged.begin() + pending);
+        delete_head = 0;
+        merged.erase(merged.begin(), merged.begin() + pending);
+        sequence_edges += merged.size();
+        insert_heap.clear();
+        add_sequence(std::move(merged), 0);
+    }
+
+    /**
+     * @brief Rellena el buffer de borrado con las menores aristas de las secuencias
+     */
+    void refill()
+    {
+        std::vector<sequence*> inputs;
+        for (std::vector<sequence>& group : groups) {
+            std::erase_if(group, [](const sequence& seq) { return seq.size() == 0; });
+            for (sequence& seq : group) inputs.push_back(&seq);
+        }
+        const size_t count = std::min(DELETE_CAPACITY, sequence_edges);
+        delete_buffer.clear();
+        delete_head = 0;
+        multiway_merge(inputs, delete_buffer, count);
+        sequence_edges -= count;
+    }
+
+    edge pop()
+    {
+        if (delete_head == delete_buffer.size() && sequence_edges > 0) refill();
+        if (!insert_heap.empty() && (delete_head == delete_buffer.size()
+                                     || insert_heap.front().weight < delete_buffer[delete_head].weight)) {
+            std::pop_heap(insert_heap.begin(), insert_heap.end(), heap_order);
+            edge min_edge = insert_heap.back();
+            insert_heap.pop_back();
+            return min_edge;
+        }
+        return delete_buffer[delete_head++];
+    }
+
+public:
+    /**
+     * @brief Constructor por defecto
+     */
+    SequenceHeap() { insert_heap.reserve(INSERT_CAPACITY); }
+
+    void insert_edge(const edge& e) override
+    {
+        insert_heap.push_back(e);
+        std::push_heap(insert_heap.begin(), insert_heap.end(), heap_order);
+        if (insert_heap.size() == INSERT_CAPACITY) flush_insert_heap();
+    }
+
+    void clear() override
+    {
+        insert_heap.clear();
+        delete_buffer.clear();
+        delete_head = 0;
+        groups.clear();
+        sequence_edges = 0;
+    }
+
+    edge extract_min() override { return pop(); }
+
+    size_t extract_batch(edge* out, size_t k) override
+    {
+        size_t count = std::min<size_t>(k, size());
+        for (size_t i = 0; i < count; ++i) out[i] = pop();
+        return count;
+    }
+
+    const std::string get_name() override { return "SequenceHeap"; }
+
+    unsigned int size() override { return pending(); }
+
+    bool operator==(const SequenceHeap &other) const { return pending() == other.pending(); }
+
+    SequenceHeap *clone() override
+    {
+        SequenceHeap *new_heap = new SequenceHeap(*this);
+        return new_heap;
+    }
+};
+
+/**
+ * @brief Crea un extractor a partir de su nombre
+ * @param name Nombre del extractor (el mismo que retorna get_name())
+ * @return Puntero a nueva instancia, o nullptr si el nombre no existe
+ */
+inline EdgeExtractor* make_edge_extractor(const std::string& name)
+{
+    if (name == "ArraySort") return new ArraySort();
+    if (name == "HeapMin") return new HeapMin();
+    if (name == "RunMerge") return new RunMerge();
+    if (name == "SequenceHeap") return new SequenceHeap();
+    return nullptr;
+}
+
 #endif
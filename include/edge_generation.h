@@ -0,0 +1,228 @@
+#ifndef EDGE_GENERATION_H
+#define EDGE_GENERATION_H
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+#include "edge_extractor.h"
+#include "metric.h"
+#include "point_set.h"
+
+/**
+ * @brief Conjunto de aristas que se genera a partir de los puntos
+ */
+enum class edge_mode
+{
+    complete, ///< Todos los pares: n(n-1)/2 aristas (comportamiento original)
+    radius    ///< Solo pares con peso menor o igual a un umbral, vía grilla espacial
+};
+
+/**
+ * @brief Convierte el nombre de un modo ("complete", "radius")
+ * @param name Nombre del modo
+ * @param mode Modo resultante
+ * @return false si el nombre no existe
+ */
+bool parse_edge_mode(const std::string& name, edge_mode& mode);
+
+/**
+ * @brief Indica si las aristas conectan todos los vértices
+ * Si conectan, el MST de ese subgrafo (aristas de peso <= umbral) es también un MST
+ * del grafo completo: Kruskal rechazaría todas las aristas más pesadas.
+ * @param edges Aristas
+ * @param num_nodes Número de vértices
+ * @return true si el grafo es conexo
+ */
+bool edges_span(const edge_vector& edges, int num_nodes);
+
+namespace edge_generation_detail {
+
+/**
+ * @brief Máximo de celdas por eje de la grilla (acota su memoria para umbrales muy chicos)
+ */
+constexpr size_t MAX_GRID_SIDE = 4096;
+
+/**
+ * @brief Celda de una coordenada normalizada (0 = borde inferior de la caja de los puntos)
+ * Se acota en double antes de convertir: un valor negativo o mayor que el rango de
+ * size_t no tiene conversión definida.
+ */
+inline size_t cell_of(double normalized, size_t side)
+{
+    return static_cast<size_t>(std::clamp(normalized * side, 0.0, static_cast<double>(side - 1)));
+}
+
+} // namespace edge_generation_detail
+
+/**
+ * @brief Genera todas las aristas del grafo completo, con u < v
+ * Los pesos de cada fila se calculan con metric_row() (kernel AVX2 para las
+ * métricas incluidas) y luego se emiten las aristas.
+ * @tparam Metric Política de métrica (por omisión distancia euclidiana al cuadrado)
+ * @param nodes Puntos
+ * @param edges Vector de salida (se agregan al final)
+ */
+template <metric_policy Metric = squared_l2>
+void generate_complete_edges(const std::vector<node>& nodes, edge_vector& edges)
+{
+    if (nodes.size() < 2) return;
+    const size_t n = nodes.size();
+    edges.reserve(edges.size() + n * (n - 1) / 2);
+    std::vector<double> row(n);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t count = n - i - 1;
+        metric_row<Metric>(nodes[i], nodes.data() + i + 1, count, row.data());
+        for (size_t k = 0; k < count; ++k) {
+            edges.emplace_back(static_cast<int>(i), static_cast<int>(i + 1 + k), row[k]);
+        }
+    }
+}
+
+/**
+ * @brief Genera todas las aristas del grafo completo sobre puntos d-dimensionales, con u < v
+ * Recorre cada fila coordenada a coordenada sobre el almacenamiento SoA.
+ * @tparam Metric Política de métrica definida por coordenada
+ * @param points Puntos
+ * @param edges Vector de salida (se agregan al final)
+ */
+template <coordinate_metric Metric = squared_l2, size_t D>
+void generate_complete_edges(const PointSet<D>& points, edge_vector& edges)
+{
+    if (points.size() < 2) return;
+    const size_t n = points.size();
+    edges.reserve(edges.size() + n * (n - 1) / 2);
+    std::vector<double> row(n);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t count = n - i - 1;
+        std::fill(row.begin(), row.begin() + count, 0.0);
+        for (size_t d = 0; d < D; ++d) {
+            const double* axis = points.axis(d) + i + 1;
+            const double coordinate = points(i, d);
+            for (size_t k = 0; k < count; ++k) row[k] = Metric::accumulate(row[k], coordinate - axis[k]);
+        }
+        for (size_t k = 0; k < count; ++k) {
+            edges.emplace_back(static_cast<int>(i), static_cast<int>(i + 1 + k), row[k]);
+        }
+    }
+}
+
+/**
+ * @brief Umbral inicial de peso: el de un par a distancia euclidiana sqrt(c·ln(n)/n)
+ * Para puntos uniformes en el cuadrado unitario, todas las aristas del MST euclidiano son
+ * casi seguramente más cortas que sqrt(ln(n)/(πn)), así que c > 1/π basta con alta probabilidad.
+ * Con squared_l2 el umbral es c·ln(n)/n; con otras métricas es una estimación y
+ * generate_spanning_radius_edges() lo agranda si no alcanza.
+ * @tparam Metric Política de métrica
+ * @param n Número de puntos
+ * @param c Constante del umbral
+ * @return Umbral sobre el peso de las aristas
+ */
+template <metric_policy Metric = squared_l2>
+double radius_threshold(size_t n, double c)
+{
+    if (n < 2) return Metric::max_weight;
+    return std::min(Metric::max_weight, Metric::weight(std::sqrt(c * std::log(static_cast<double>(n)) / n)));
+}
+
+/**
+ * @brief Genera solo las aristas con peso <= max_weight, con u < v
+ * Agrupa los puntos en una grilla de celdas de lado >= Metric::radius(max_weight) sobre su
+ * caja y compara cada punto con los de su celda y las 8 vecinas: O(n + aristas emitidas)
+ * esperado para puntos uniformes.
+ * @tparam Metric Política de métrica
+ * @param nodes Puntos (cualquier coordenada finita)
+ * @param max_weight Umbral sobre el peso
+ * @param edges Vector de salida (se agregan al final)
+ */
+template <metric_policy Metric = squared_l2>
+void generate_radius_edges(const std::vector<node>& nodes, double max_weight, edge_vector& edges)
+{
+    using edge_generation_detail::cell_of;
+    if (max_weight >= Metric::max_weight) {
+        generate_complete_edges<Metric>(nodes, edges);
+        return;
+    }
+
+    // Grilla sobre la caja de los puntos (el servicio acepta cualquier coordenada finita).
+    // Celdas de lado >= radio: todo vecino dentro del radio está en las 3x3 celdas cercanas
+    const double radius = Metric::radius(max_weight);
+    double min_x = nodes.empty() ? 0.0 : nodes[0].x, max_x = min_x;
+    double min_y = nodes.empty() ? 0.0 : nodes[0].y, max_y = min_y;
+    for (const node& p : nodes) {
+        min_x = std::min(min_x, p.x);
+        max_x = std::max(max_x, p.x);
+        min_y = std::min(min_y, p.y);
+        max_y = std::max(max_y, p.y);
+    }
+    const double extent = std::max(max_x - min_x, max_y - min_y);
+    const double cells = std::min(extent / radius, static_cast<double>(edge_generation_detail::MAX_GRID_SIDE));
+    const size_t side = std::max<size_t>(1, static_cast<size_t>(cells));
+    const double scale = extent > 0 ? 1.0 / extent : 0.0;
+
+    // Ordenamiento por conteo de los puntos según su celda
+    std::vector<int> cell_start(side * side + 1, 0);
+    std::vector<int> cell_points(nodes.size());
+    std::vector<size_t> point_cell(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        point_cell[i] = cell_of((nodes[i].y - min_y) * scale, side) * side + cell_of((nodes[i].x - min_x) * scale, side);
+        cell_start[point_cell[i] + 1]++;
+    }
+    for (size_t c = 0; c < side * side; ++c) cell_start[c + 1] += cell_start[c];
+    std::vector<int> fill(cell_start.begin(), cell_start.end() - 1);
+    for (size_t i = 0; i < nodes.size(); ++i) cell_points[fill[point_cell[i]]++] = static_cast<int>(i);
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const long cx = static_cast<long>(point_cell[i] % side);
+        const long cy = static_cast<long>(point_cell[i] / side);
+        for (long ny = std::max(0L, cy - 1); ny <= std::min<long>(side - 1, cy + 1); ++ny) {
+            for (long nx = std::max(0L, cx - 1); nx <= std::min<long>(side - 1, cx + 1); ++nx) {
+                const size_t cell = ny * side + nx;
+                for (int k = cell_start[cell]; k < cell_start[cell + 1]; ++k) {
+                    const int j = cell_points[k];
+                    if (j <= static_cast<int>(i)) continue; // Cada par una sola vez, con u < v
+                    double weight = Metric::distance(nodes[i], nodes[j]);
+                    if (weight <= max_weight) edges.emplace_back(static_cast<int>(i), j, weight);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Resultado de generate_spanning_radius_edges()
+ */
+struct radius_generation
+{
+    double threshold;      ///< Umbral con que se generaron las aristas finales
+    unsigned int attempts; ///< Generaciones realizadas (1 si el umbral inicial bastó)
+};
+
+/**
+ * @brief Genera aristas acotadas por radio hasta que el grafo sea conexo
+ * Parte de radius_threshold<Metric>(n, c) y duplica el umbral en cada reintento; con un
+ * umbral >= Metric::max_weight el grafo es el completo, así que siempre termina. El MST resultante es exacto.
+ * @tparam Metric Política de métrica
+ * @param nodes Puntos (el umbral inicial supone [0,1]^2; con otra caja solo cambian los reintentos)
+ * @param c Constante del umbral inicial
+ * @param edges Vector de salida (se reemplaza su contenido)
+ * @return Umbral final y número de intentos
+ */
+template <metric_policy Metric = squared_l2>
+radius_generation generate_spanning_radius_edges(const std::vector<node>& nodes, double c, edge_vector& edges)
+{
+    radius_generation generation = {radius_threshold<Metric>(nodes.size(), c), 0};
+    while (true) {
+        edges.clear();
+        generate_radius_edges<Metric>(nodes, generation.threshold, edges);
+        generation.attempts++;
+        if (generation.threshold >= Metric::max_weight || edges_span(edges, static_cast<int>(nodes.size()))) {
+            return generation;
+        }
+        generation.threshold = std::min(Metric::max_weight, 2 * generation.threshold);
+    }
+}
+
+#endif
@@ -1,7 +1,38 @@
 #ifndef KRUSKAL_H
 #define KRUSKAL_H
 
+#include <vector>
+
 #include "edge_extractor.h"
+#include "reconstruction_tree.h"
+
+/**
+ * @brief Indica si los contadores de instrumentación están compilados (make STATS=1)
+ */
+#ifdef KRUSKAL_STATS
+constexpr bool KRUSKAL_STATS_ENABLED = true;
+#else
+constexpr bool KRUSKAL_STATS_ENABLED = false;
+#endif
+
+/**
+ * @brief Contadores del ciclo de Kruskal y de su Union-Find
+ * Solo se llenan si se compila con -DKRUSKAL_STATS; si no, quedan en cero.
+ */
+struct kruskal_stats {
+    unsigned long long edges_extracted = 0;   ///< Aristas extraídas del extractor
+    unsigned long long edges_accepted = 0;    ///< Aristas agregadas al MST
+    unsigned long long last_useful_edge = 0;  ///< Posición (desde 0) en el orden de extracción de la última arista aceptada
+    unsigned long long find_calls = 0;        ///< Llamadas a find (incluye las de connected y unite)
+    unsigned long long path_length_total = 0; ///< Suma de saltos padre recorridos por find
+    unsigned long long path_length_max = 0;   ///< Mayor número de saltos de un find
+    unsigned long long compressions = 0;      ///< Punteros padre reescritos por path compression
+};
+
+/**
+ * @brief Aristas que Kruskal pide al extractor en cada extract_batch()
+ */
+constexpr size_t KRUSKAL_DEFAULT_BATCH = 64;
 
 /**
  * @brief Implementación del algoritmo de Kruskal
@@ -11,6 +42,29 @@
  */
 void* kruskal(EdgeExtractor *extractor, const bool opti_path);
 
+/**
+ * @brief Opciones de una ejecución de Kruskal
+ */
+struct kruskal_options {
+    size_t batch_size = KRUSKAL_DEFAULT_BATCH; ///< Aristas por extract_batch(); 1 procesa arista por arista sin prefetch
+    int num_nodes = 0;                         ///< Número de vértices; 0 lo deduce suponiendo un grafo completo
+    bool reconstruction_tree = false;          ///< Construir el árbol de reconstrucción y su índice LCA
+    int clusters = 0;                          ///< k-clustering: detenerse en k componentes sin guardar aristas (0 = MST completo)
+};
+
+/**
+ * @brief Kruskal extrayendo las aristas por lotes
+ * Mientras procesa una arista pide a la caché parent[u]/parent[v] de las siguientes
+ * del lote, y une directamente las raíces halladas al verificar el ciclo.
+ * Puede extraer hasta batch_size - 1 aristas más de las que usa. Si el grafo no es
+ * conexo el resultado es un bosque con menos de num_nodes - 1 aristas.
+ * @param extractor Puntero a estructura de extracción de aristas
+ * @param opti_path Si usar optimización path compression en Union-Find
+ * @param options Tamaño de lote y número de vértices
+ * @return Puntero a ResultadoKruskal conteniendo el MST
+ */
+void* kruskal(EdgeExtractor *extractor, const bool opti_path, const kruskal_options& options);
+
 /**
  * @brief Función auxiliar para liberar memoria de ResultadoKruskal
  * @param result Puntero a ResultadoKruskal a liberar
@@ -31,4 +85,59 @@ double get_mst_weight(void* result);
  */
 int get_mst_edge_count(void* result);
 
+/**
+ * @brief Función auxiliar para obtener los contadores de instrumentación
+ * @param result Puntero a ResultadoKruskal
+ * @return Contadores de la ejecución (en cero si no se compiló con KRUSKAL_STATS)
+ */
+kruskal_stats get_kruskal_stats(void* result);
+
+/**
+ * @brief Asocia al resultado la numeración original de los vértices
+ * Se usa cuando los puntos se renumeraron (p.ej. por curva de Hilbert) antes de
+ * generar las aristas; el MST sigue expresado en los ids con que se ejecutó.
+ * @param result Puntero a ResultadoKruskal
+ * @param original_ids original_ids[v] = id original del vértice v (vacío = sin renumeración)
+ */
+void set_vertex_mapping(void* result, const std::vector<int>& original_ids);
+
+/**
+ * @brief Función auxiliar para obtener las aristas del MST con los ids originales
+ * @param result Puntero a ResultadoKruskal
+ * @return Aristas del MST; si hay renumeración, u y v se traducen a los ids originales
+ */
+std::vector<edge> get_mst_edges(void* result);
+
+/**
+ * @brief Etiquetas de cluster de cada vértice (kruskal_options::clusters > 0)
+ * El single-linkage con k clusters son los componentes tras las n-k primeras uniones.
+ * @param result Puntero a ResultadoKruskal
+ * @return Etiquetas compactas en 0..k-1, o vacío si no se pidió k-clustering
+ */
+std::vector<int> get_cluster_labels(void* result);
+
+/**
+ * @brief Peso de la última unión realizada (en modo k-clustering, la distancia a la que se detuvo)
+ * @param result Puntero a ResultadoKruskal
+ * @return Distancia de la última unión, 0 si no hubo uniones
+ */
+double get_merge_distance(void* result);
+
+/**
+ * @brief Árbol de reconstrucción construido por kruskal() (kruskal_options::reconstruction_tree)
+ * @param result Puntero a ResultadoKruskal
+ * @return Árbol con su índice LCA, o nullptr si no se pidió
+ */
+const KruskalReconstructionTree* get_reconstruction_tree(void* result);
+
+/**
+ * @brief Distancia minimax entre dos vértices: arista más pesada del camino en el MST
+ * Requiere el árbol de reconstrucción; O(1) por consulta.
+ * @param result Puntero a ResultadoKruskal
+ * @param u Primer vértice
+ * @param v Segundo vértice
+ * @return Peso de la arista cuello de botella (infinito si no se construyó el árbol o no están conectados)
+ */
+double get_bottleneck_weight(void* result, int u, int v);
+
 #endif
@@ -0,0 +1,43 @@
+#ifndef MEM_TRACKER_H
+#define MEM_TRACKER_H
+
+/**
+ * @brief Contadores de memoria dinámica del hilo actual
+ * Se actualizan desde los operator new/delete globales que reemplaza
+ * src/mem_tracker.cpp; en un binario que no enlaza ese archivo quedan en cero.
+ */
+struct alloc_snapshot
+{
+    unsigned long long count;      ///< Número de asignaciones realizadas
+    unsigned long long bytes;      ///< Bytes asignados en total (acumulado)
+    long long live_bytes;          ///< Bytes asignados y aún no liberados por este hilo
+    long long peak_live_bytes;     ///< Máximo de live_bytes desde el último reset_thread_peak()
+};
+
+/**
+ * @brief Contadores de asignación del hilo actual
+ * La diferencia entre dos lecturas da lo asignado por el código intermedio.
+ * @return Copia de los contadores
+ */
+alloc_snapshot thread_allocations();
+
+/**
+ * @brief Reinicia el máximo de memoria viva del hilo al valor actual
+ */
+void reset_thread_peak();
+
+/**
+ * @brief Memoria residente máxima del proceso (VmHWM de /proc/self/status)
+ * @return Kilobytes, o -1 si no se pudo leer
+ */
+long peak_rss_kb();
+
+/**
+ * @brief Reinicia el máximo de memoria residente del proceso
+ * Escribe "5" en /proc/self/clear_refs (Linux >= 4.0). Solo tiene sentido por
+ * experimento cuando corre un único hilo de trabajo.
+ * @return true si el kernel aceptó el reinicio
+ */
+bool reset_peak_rss();
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef METRIC_H
+#define METRIC_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <string>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "utils.h"
+
+/**
+ * Políticas de métrica resueltas en tiempo de compilación. La generación de
+ * aristas (y cualquier motor geométrico) es una plantilla sobre la política, de
+ * modo que el ciclo n² llama a una función constexpr que se inlinea, sin ramas
+ * ni punteros a función por par de puntos.
+ *
+ * Una política es un tipo con:
+ *   static double distance(const node&, const node&)  peso de la arista (constexpr)
+ *   static double radius(double weight)   cota de |dx| y |dy| de los pares con peso <= weight
+ *   static double weight(double radius)   peso de un par a distancia euclidiana radius (inversa de radius())
+ *   static constexpr double max_weight    mayor peso posible en el cuadrado unitario
+ * Las métricas de puntos d-dimensionales (coordinate_metric) agregan además
+ *   static double accumulate(double acc, double diff)  pliega la diferencia de una coordenada
+ * de modo que el peso es accumulate(...accumulate(0, diff_0)..., diff_{d-1}); aplicado a
+ * las separaciones entre dos cajas da una cota inferior del peso entre sus puntos.
+ * Un usuario puede definir la suya (p.ej. L2 con pesos por eje) y pasarla como
+ * parámetro de plantilla; si además especializa metric_simd, usa el kernel AVX2.
+ */
+
+/**
+ * @brief Requisitos de una política de métrica
+ */
+template <typename M>
+concept metric_policy = requires(const node& a, const node& b, double w) {
+    { M::distance(a, b) } -> std::convertible_to<double>;
+    { M::radius(w) } -> std::convertible_to<double>;
+    { M::weight(w) } -> std::convertible_to<double>;
+    { M::max_weight } -> std::convertible_to<double>;
+};
+
+/**
+ * @brief Distancia euclidiana al cuadrado (la métrica original del proyecto)
+ */
+struct squared_l2
+{
+    static constexpr double max_weight = 2.0;
+    static constexpr double distance(const node& a, const node& b)
+    {
+        const double dx = a.x - b.x;
+        const double dy = a.y - b.y;
+        return dx * dx + dy * dy;
+    }
+    static double radius(double weight) { return std::sqrt(weight); }
+    static constexpr double weight(double radius) { return radius * radius; }
+    static constexpr double accumulate(double acc, double diff) { return acc + diff * diff; }
+};
+
+/**
+ * @brief Distancia Manhattan (L1)
+ */
+struct l1_distance
+{
+    static constexpr double max_weight = 2.0;
+    static constexpr double distance(const node& a, const node& b)
+    {
+        return (a.x > b.x ? a.x - b.x : b.x - a.x) + (a.y > b.y ? a.y - b.y : b.y - a.y);
+    }
+    static constexpr double radius(double weight) { return weight; }
+    static constexpr double weight(double radius) { return radius; }
+    static constexpr double accumulate(double acc, double diff) { return acc + (diff < 0 ? -diff : diff); }
+};
+
+/**
+ * @brief Distancia de Chebyshev (L∞)
+ */
+struct linf_distance
+{
+    static constexpr double max_weight = 1.0;
+    static constexpr double distance(const node& a, const node& b)
+    {
+        const double dx = a.x > b.x ? a.x - b.x : b.x - a.x;
+        const double dy = a.y > b.y ? a.y - b.y : b.y - a.y;
+        return dx > dy ? dx : dy;
+    }
+    static constexpr double radius(double weight) { return weight; }
+    static constexpr double weight(double radius) { return radius; }
+    static constexpr double accumulate(double acc, double diff)
+    {
+        const double d = diff < 0 ? -diff : diff;
+        return acc > d ? acc : d;
+    }
+};
+
+/**
+ * @brief Métrica que además se define coordenada a coordenada (puntos d-dimensionales)
+ */
+template <typename M>
+concept coordinate_metric = metric_policy<M> && requires(double acc, double diff) {
+    { M::accumulate(acc, diff) } -> std::convertible_to<double>;
+};
+
+static_assert(coordinate_metric<squared_l2> && coordinate_metric<l1_distance> && coordinate_metric<linf_distance>);
+
+#if defined(__x86_64__)
+#define METRIC_AVX2_TARGET __attribute__((target("avx2")))
+
+/**
+ * @brief Kernel AVX2 de una política: peso de 4 pares a partir de sus |dx|, |dy| con signo
+ * Sin especializar (políticas de usuario) available es false y se usa distance().
+ */
+template <typename M>
+struct metric_simd
+{
+    static constexpr bool available = false;
+};
+
+template <>
+struct metric_simd<squared_l2>
+{
+    static constexpr bool available = true;
+    METRIC_AVX2_TARGET static __m256d apply(__m256d dx, __m256d dy)
+    {
+        return _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+    }
+};
+
+template <>
+struct metric_simd<l1_distance>
+{
+    static constexpr bool available = true;
+    METRIC_AVX2_TARGET static __m256d apply(__m256d dx, __m256d dy)
+    {
+        const __m256d sign = _mm256_set1_pd(-0.0);
+        return _mm256_add_pd(_mm256_andnot_pd(sign, dx), _mm256_andnot_pd(sign, dy));
+    }
+};
+
+template <>
+struct metric_simd<linf_distance>
+{
+    static constexpr bool available = true;
+    METRIC_AVX2_TARGET static __m256d apply(__m256d dx, __m256d dy)
+    {
+        const __m256d sign = _mm256_set1_pd(-0.0);
+        return _mm256_max_pd(_mm256_andnot_pd(sign, dx), _mm256_andnot_pd(sign, dy));
+    }
+};
+
+/**
+ * @brief Pesos de p contra q[0..count) con el kernel AVX2 de la política
+ * Carga 4 puntos (x0 y0 x1 y1 | x2 y2 x3 y3), separa las x de las y y calcula 4 pesos por iteración.
+ */
+template <typename M>
+METRIC_AVX2_TARGET void metric_row_avx2(const node& p, const node* q, size_t count, double* out)
+{
+    static_assert(sizeof(node) == 2 * sizeof(double));
+    const __m256d px = _mm256_set1_pd(p.x);
+    const __m256d py = _mm256_set1_pd(p.y);
+    const double* raw = reinterpret_cast<const double*>(q);
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+        const __m256d a = _mm256_loadu_pd(raw + 2 * j);      // x0 y0 x1 y1
+        const __m256d b = _mm256_loadu_pd(raw + 2 * j + 4);  // x2 y2 x3 y3
+        // unpack deja x0 x2 x1 x3; la permutación restaura el orden de los puntos
+        const __m256d xs = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), 0xD8);
+        const __m256d ys = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), 0xD8);
+        _mm256_storeu_pd(out + j, metric_simd<M>::apply(_mm256_sub_pd(px, xs), _mm256_sub_pd(py, ys)));
+    }
+    for (; j < count; ++j) out[j] = M::distance(p, q[j]);
+}
+#endif
+
+/**
+ * @brief Pesos de p contra q[0..count): kernel AVX2 si la política y la CPU lo permiten
+ * La decisión se toma una vez por fila, fuera del ciclo interno.
+ */
+template <metric_policy M>
+void metric_row(const node& p, const node* q, size_t count, double* out)
+{
+#if defined(__x86_64__)
+    if constexpr (metric_simd<M>::available) {
+        static const bool has_avx2 = __builtin_cpu_supports("avx2");
+        if (has_avx2) {
+            metric_row_avx2<M>(p, q, count, out);
+            return;
+        }
+    }
+#endif
+    for (size_t j = 0; j < count; ++j) out[j] = M::distance(p, q[j]);
+}
+
+/**
+ * @brief Métricas que se pueden elegir al ejecutar (--metric)
+ */
+enum class metric_kind
+{
+    sqeuclidean, ///< squared_l2 (comportamiento original)
+    l1,          ///< l1_distance
+    linf         ///< linf_distance
+};
+
+/**
+ * @brief Convierte el nombre de una métrica ("sqeuclidean", "l1", "linf")
+ * @return false si el nombre no existe
+ */
+inline bool parse_metric(const std::string& name, metric_kind& kind)
+{
+    if (name == "sqeuclidean") { kind = metric_kind::sqeuclidean; return true; }
+    if (name == "l1") { kind = metric_kind::l1; return true; }
+    if (name == "linf") { kind = metric_kind::linf; return true; }
+    return false;
+}
+
+/**
+ * @brief Llama a f con la política elegida al ejecutar
+ * El despacho ocurre una vez por llamada; dentro de f la métrica es un tipo
+ * (decltype del argumento) y todo el código que la usa se instancia para él.
+ * @param kind Métrica elegida
+ * @param f Callable genérico que recibe squared_l2{}, l1_distance{} o linf_distance{}
+ */
+template <typename F>
+decltype(auto) with_metric(metric_kind kind, F&& f)
+{
+    switch (kind) {
+    case metric_kind::l1: return f(l1_distance{});
+    case metric_kind::linf: return f(linf_distance{});
+    case metric_kind::sqeuclidean: break;
+    }
+    return f(squared_l2{});
+}
+
+#endif
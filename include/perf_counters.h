@@ -0,0 +1,80 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <string>
+
+/**
+ * @brief Contadores de hardware que se registran por fase del experimento
+ */
+enum perf_event_kind
+{
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_EVENT_COUNT
+};
+
+/**
+ * @brief Nombres de los contadores, usados como sufijo de las columnas del CSV
+ */
+inline const std::array<std::string, PERF_EVENT_COUNT> PERF_EVENT_NAMES = {
+    "Cycles", "Instructions", "L1DMisses", "LLCMisses", "BranchMisses", "DTLBMisses"
+};
+
+/**
+ * @brief Lectura de los contadores de una fase
+ * Un contador que no se pudo abrir queda con valid = false.
+ */
+struct perf_sample
+{
+    std::array<bool, PERF_EVENT_COUNT> valid{};                ///< Si el contador está disponible
+    std::array<unsigned long long, PERF_EVENT_COUNT> value{};  ///< Valor (escalado si hubo multiplexación)
+};
+
+/**
+ * @brief Contadores de hardware del hilo actual usando perf_event_open
+ * Cada contador se abre por separado, así que si el kernel o la CPU no soportan
+ * alguno (o perf_event_paranoid lo impide) el resto sigue funcionando. Si no hay
+ * ninguno disponible start()/stop() no hacen nada y las lecturas quedan inválidas.
+ * Solo cuenta eventos en espacio de usuario del hilo que creó el objeto y de los
+ * hilos que este lance, que se suman cuando terminan (antes de stop(), como los
+ * de RunMerge::prepare(), que se unen dentro de la fase).
+ */
+class PerfCounters
+{
+private:
+    std::array<int, PERF_EVENT_COUNT> fds; ///< Descriptores de cada contador (-1 si no está disponible)
+
+public:
+    /**
+     * @brief Abre los contadores para el hilo actual (quedan detenidos)
+     */
+    PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * @brief Indica si al menos un contador está disponible
+     */
+    bool available() const;
+
+    /**
+     * @brief Reinicia y activa los contadores
+     */
+    void start();
+
+    /**
+     * @brief Detiene los contadores y retorna sus valores desde el último start()
+     * @return Lectura de la fase
+     */
+    perf_sample stop();
+
+    ~PerfCounters();
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef POINT_SET_H
+#define POINT_SET_H
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "utils.h"
+#include "metric.h"
+
+/**
+ * @brief Puntos de dimensión D guardados por coordenada (SoA)
+ * coords[d] tiene la coordenada d de todos los puntos, así que recorrer una
+ * coordenada de un rango de puntos es un acceso contiguo (kd-tree, kernels por eje).
+ * @tparam D Dimensión
+ */
+template <size_t D>
+class PointSet
+{
+    static_assert(D >= 1, "PointSet requiere al menos una dimensión");
+    std::array<std::vector<double>, D> coords; ///< coords[d][i]: coordenada d del punto i
+
+public:
+    static constexpr size_t dimension = D;
+
+    PointSet() = default;
+    explicit PointSet(size_t n) { resize(n); }
+
+    size_t size() const { return coords[0].size(); }
+    void resize(size_t n) { for (auto& axis : coords) axis.resize(n); }
+    void reserve(size_t n) { for (auto& axis : coords) axis.reserve(n); }
+
+    void push_back(const std::array<double, D>& p)
+    {
+        for (size_t d = 0; d < D; ++d) coords[d].push_back(p[d]);
+    }
+
+    double& operator()(size_t i, size_t d) { return coords[d][i]; }
+    double operator()(size_t i, size_t d) const { return coords[d][i]; }
+
+    /**
+     * @brief Coordenada d de todos los puntos, contigua
+     */
+    const double* axis(size_t d) const { return coords[d].data(); }
+
+    std::array<double, D> point(size_t i) const
+    {
+        std::array<double, D> p;
+        for (size_t d = 0; d < D; ++d) p[d] = coords[d][i];
+        return p;
+    }
+
+    /**
+     * @brief Copia puntos del plano (x, y) a un PointSet<2>
+     */
+    static PointSet from_nodes(const std::vector<node>& nodes) requires (D == 2)
+    {
+        PointSet points(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            points.coords[0][i] = nodes[i].x;
+            points.coords[1][i] = nodes[i].y;
+        }
+        return points;
+    }
+
+    /**
+     * @brief n puntos uniformes en [0,1]^D
+     */
+    static PointSet uniform(size_t n, std::mt19937& gen)
+    {
+        std::uniform_real_distribution<double> distrib(0.0, 1.0);
+        PointSet points(n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t d = 0; d < D; ++d) points.coords[d][i] = distrib(gen);
+        }
+        return points;
+    }
+};
+
+/**
+ * @brief Peso entre los puntos i y j según la métrica
+ */
+template <coordinate_metric Metric, size_t D>
+double point_distance(const PointSet<D>& points, size_t i, size_t j)
+{
+    double acc = 0.0;
+    for (size_t d = 0; d < D; ++d) acc = Metric::accumulate(acc, points(i, d) - points(j, d));
+    return acc;
+}
+
+#endif
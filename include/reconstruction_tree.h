@@ -0,0 +1,74 @@
+#ifndef RECONSTRUCTION_TREE_H
+#define RECONSTRUCTION_TREE_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Árbol de reconstrucción de Kruskal con LCA en O(1)
+ * Las hojas 0..n-1 son los vértices; cada unión de Kruskal crea un nodo interno
+ * cuyo peso es el de la arista que unió los dos componentes. El peso del LCA de
+ * u y v es la arista más pesada del camino u–v en el MST (distancia minimax).
+ * El LCA se responde con un recorrido de Euler y una sparse table de mínimos
+ * por profundidad: O(n log n) de preprocesamiento y O(1) por consulta.
+ */
+class KruskalReconstructionTree
+{
+private:
+    int num_leaves;
+    std::vector<int> parent;     ///< Padre de cada nodo (-1 en las raíces)
+    std::vector<double> weight;  ///< Peso de cada nodo interno (0 en las hojas)
+    std::vector<int> first_seen; ///< Primera posición de cada nodo en el recorrido de Euler
+    std::vector<int> tree_of;    ///< Raíz del árbol de cada nodo (el grafo puede ser un bosque)
+    std::vector<int> euler_depth;                ///< Profundidad en cada posición del recorrido
+    std::vector<int> euler_node;                 ///< Nodo en cada posición del recorrido
+    std::vector<std::vector<int>> sparse;        ///< sparse[j][i]: posición de menor profundidad en [i, i + 2^j)
+    std::vector<int> log2_floor;                 ///< floor(log2(i))
+
+public:
+    /**
+     * @brief Crea el árbol con n hojas y sin uniones
+     * @param n Número de vértices
+     */
+    explicit KruskalReconstructionTree(int n);
+
+    /**
+     * @brief Registra una unión de Kruskal
+     * @param a Nodo que representa al primer componente
+     * @param b Nodo que representa al segundo componente
+     * @param w Peso de la arista que los une
+     * @return Nodo interno nuevo, que representa al componente unido
+     */
+    int merge(int a, int b, double w);
+
+    /**
+     * @brief Construye el recorrido de Euler y la sparse table (llamar después de las uniones)
+     */
+    void build_index();
+
+    /**
+     * @brief Ancestro común más bajo de dos nodos del mismo árbol
+     * @return Nodo LCA, o -1 si están en árboles distintos
+     */
+    int lca(int u, int v) const;
+
+    /**
+     * @brief Arista más pesada del camino u–v en el MST
+     * @param u Primer vértice
+     * @param v Segundo vértice
+     * @return Peso minimax; 0 si u == v e infinito si no están conectados
+     */
+    double bottleneck(int u, int v) const;
+
+    /**
+     * @brief Número de nodos (hojas + uniones)
+     */
+    int size() const { return static_cast<int>(parent.size()); }
+
+    /**
+     * @brief Bytes ocupados por el índice
+     */
+    size_t memory_bytes() const;
+};
+
+#endif
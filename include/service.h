@@ -0,0 +1,44 @@
+#ifndef SERVICE_H
+#define SERVICE_H
+
+#include <string>
+
+#include "config.h"
+
+/**
+ * @brief Modo servicio: un proceso persistente que resuelve MST a pedido
+ *
+ * En lugar de pagar por cada instancia el arranque del proceso, la carga del
+ * modelo de costo y el crecimiento de los arreglos, el servicio mantiene vivos
+ * entre peticiones los hilos de trabajo, sus arenas, sus vectores de puntos y
+ * aristas (solo se vacían, conservando la capacidad) y un extractor por hilo
+ * que se reutiliza con EdgeExtractor::clear().
+ *
+ * Protocolo de texto, una petición tras otra en la misma conexión:
+ *   points N            seguido de N líneas "x y" (finitas); las aristas se generan según
+ *                       --edges/--radius-c y los vértices se numeran según --vertex-order
+ *   edges N M           seguido de M líneas "u v w" (0 <= u, v < N, w >= 0)
+ *   quit                cierra la conexión
+ *   shutdown            detiene el servicio (en stdin equivale a quit)
+ * Respuesta: "ok PESO K" y K líneas "u v w" con las aristas del MST (ids
+ * originales), o "error MENSAJE" y se cierra la conexión.
+ *
+ * Se usan el primer extractor de --extractors, la primera política de
+ * --opti-path y --batch; en unix:RUTA cada uno de los --threads hilos atiende
+ * una conexión a la vez.
+ */
+
+/**
+ * @brief Prefijo de --serve para escuchar en un socket Unix
+ */
+inline const std::string SERVICE_UNIX_PREFIX = "unix:";
+
+/**
+ * @brief Atiende peticiones hasta EOF en stdin o hasta recibir shutdown
+ * Los mensajes de estado van a stderr para no mezclarse con las respuestas.
+ * @param config Configuración (config.serve indica el transporte)
+ * @return Código de salida del proceso
+ */
+int run_service(const experiment_config& config);
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef SIMD_SORT_H
+#define SIMD_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Forma en que ArraySort ordena sus aristas
+ */
+enum class sort_kernel
+{
+    automatic, ///< avx2 si la CPU lo soporta, si no std_sort
+    std_sort,  ///< std::sort sobre las aristas completas (comportamiento original)
+    scalar,    ///< Pares (peso, índice) ordenados con std::sort
+    avx2       ///< Pares (peso, índice) con red de ordenamiento + mezcla bitónica AVX2
+};
+
+/**
+ * @brief Convierte el nombre de un kernel ("auto", "std", "scalar", "avx2")
+ * @param name Nombre del kernel
+ * @param kernel Kernel resultante
+ * @return false si el nombre no existe
+ */
+bool parse_sort_kernel(const std::string& name, sort_kernel& kernel);
+
+/**
+ * @brief Nombre de un kernel, el mismo que acepta parse_sort_kernel()
+ */
+std::string sort_kernel_name(sort_kernel kernel);
+
+/**
+ * @brief Indica si la CPU actual puede ejecutar un kernel
+ */
+bool sort_kernel_supported(sort_kernel kernel);
+
+/**
+ * @brief Fija el kernel que usa ArraySort en todo el proceso
+ * automatic se resuelve aquí según la CPU; un kernel no soportado cae a std_sort
+ * (los pares con std::sort solo convienen cuando hay un kernel vectorial).
+ * @param kernel Kernel pedido
+ */
+void set_sort_kernel(sort_kernel kernel);
+
+/**
+ * @brief Kernel que usa ArraySort (ya resuelto: nunca automatic)
+ */
+sort_kernel active_sort_kernel();
+
+/**
+ * @brief Ordena pares (clave, índice) de menor a mayor clave
+ * Las claves deben ser no negativas y sin NaN (pesos de aristas). Los índices se
+ * permutan junto con sus claves; el orden entre claves iguales no se garantiza,
+ * igual que con std::sort.
+ * @param keys Claves; se reordenan en el lugar
+ * @param index Índices asociados (mismo tamaño); se reordenan en el lugar
+ * @param kernel avx2 usa el kernel vectorial si la CPU lo soporta; cualquier otro valor usa std::sort sobre los pares
+ */
+void sort_key_index(std::vector<double>& keys, std::vector<uint32_t>& index, sort_kernel kernel);
+
+/**
+ * @brief Buffers temporales de sort_key_index(), reutilizables entre llamadas
+ */
+struct sort_scratch
+{
+    std::vector<double> keys;
+    std::vector<uint32_t> index;
+};
+
+/**
+ * @brief Igual que sort_key_index(), pero con los buffers temporales del llamador
+ * Evita reservar memoria en cada llamada cuando se ordenan muchos arreglos chicos.
+ * @param scratch Buffers temporales; conservan su capacidad para la próxima llamada
+ */
+void sort_key_index(std::vector<double>& keys, std::vector<uint32_t>& index, sort_kernel kernel, sort_scratch& scratch);
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef SPATIAL_ORDER_H
+#define SPATIAL_ORDER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+
+/**
+ * @brief Orden en que se numeran los vértices antes de generar las aristas
+ */
+enum class vertex_order
+{
+    generation, ///< Orden de generación (comportamiento original)
+    morton,     ///< Curva Z (entrelazado de bits de x e y)
+    hilbert     ///< Curva de Hilbert
+};
+
+/**
+ * @brief Convierte el nombre de un orden ("generation", "morton", "hilbert")
+ * @param name Nombre del orden
+ * @param order Orden resultante
+ * @return false si el nombre no existe
+ */
+bool parse_vertex_order(const std::string& name, vertex_order& order);
+
+/**
+ * @brief Posición de un punto sobre la curva de Morton en una grilla de 2^16 x 2^16
+ * @param p Punto en [0,1]^2
+ * @return Índice sobre la curva
+ */
+uint64_t morton_index(const node& p);
+
+/**
+ * @brief Posición de un punto sobre la curva de Hilbert en una grilla de 2^16 x 2^16
+ * @param p Punto en [0,1]^2
+ * @return Índice sobre la curva
+ */
+uint64_t hilbert_index(const node& p);
+
+/**
+ * @brief Renumera los vértices según una curva que preserva la localidad espacial
+ * Puntos cercanos quedan con ids cercanos, así que las aristas cortas que Kruskal
+ * procesa primero tocan entradas cercanas de parent[]/size[] en el Union-Find.
+ * @param nodes Puntos; se reordenan en el lugar
+ * @param order Curva a usar
+ * @return original_ids[v] = índice del vértice v en el orden de generación
+ *         (vacío si order es generation y no hubo cambios)
+ */
+std::vector<int> reorder_vertices(std::vector<node>& nodes, vertex_order order);
+
+#endif
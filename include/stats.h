@@ -0,0 +1,68 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Resumen robusto de una serie de mediciones
+ */
+struct sample_summary
+{
+    unsigned int count;  ///< Número de mediciones consideradas
+    double median;       ///< Mediana
+    double mad;          ///< Desviación absoluta mediana (sin escalar)
+    double ci95_low;     ///< Cota inferior del intervalo de confianza 95% de la mediana
+    double ci95_high;    ///< Cota superior del intervalo de confianza 95% de la mediana
+    unsigned int outliers; ///< Mediciones marcadas como outliers
+};
+
+/**
+ * @brief Mediana de un conjunto de valores
+ * @param values Valores (se copian para no alterar el orden original)
+ * @return Mediana, o 0 si no hay valores
+ */
+double median(std::vector<double> values);
+
+/**
+ * @brief Desviación absoluta mediana: mediana de |x - mediana(x)|
+ * @param values Valores
+ * @return MAD sin el factor de escala 1.4826
+ */
+double median_absolute_deviation(const std::vector<double>& values);
+
+/**
+ * @brief Indica si un valor es outlier según el z-score modificado de Iglewicz-Hoaglin
+ * Un valor es outlier si 0.6745 * |x - mediana| / MAD > 3.5.
+ * @param value Valor a evaluar
+ * @param med Mediana del grupo
+ * @param mad MAD del grupo
+ * @return true si el valor es outlier
+ */
+bool is_outlier(double value, double med, double mad);
+
+/**
+ * @brief Calcula mediana, MAD, intervalo de confianza 95% y outliers
+ * El intervalo de la mediana se obtiene por estadísticos de orden (sin suponer
+ * normalidad), usando la aproximación normal de la binomial(n, 1/2).
+ * @param values Valores medidos
+ * @return Resumen de la serie
+ */
+sample_summary summarize(const std::vector<double>& values);
+
+/**
+ * @brief Intervalo de confianza bootstrap del cociente de medianas
+ * Remuestrea con reemplazo cada serie por separado y toma los percentiles
+ * (1-confianza)/2 y (1+confianza)/2 de mediana(numerator*) / mediana(denominator*).
+ * Con una sola medición por serie el intervalo se reduce al cociente observado.
+ * @param numerator Serie del numerador (p.ej. tiempos de la línea base)
+ * @param denominator Serie del denominador (p.ej. tiempos del candidato)
+ * @param resamples Remuestreos
+ * @param seed Semilla del generador, para que el intervalo sea reproducible
+ * @param confidence Nivel de confianza (0.95 = 95%)
+ * @return Cotas inferior y superior del intervalo
+ */
+std::pair<double, double> bootstrap_median_ratio_ci(const std::vector<double>& numerator, const std::vector<double>& denominator,
+                                                    unsigned int resamples, unsigned int seed, double confidence = 0.95);
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <chrono>
+#include <string>
+
+/**
+ * @brief Registro de fases por hilo en formato Chrome trace-event (JSON)
+ * Cada hilo escribe en su propio buffer, sin locks después de registrarse, y al
+ * final write() vuelca todos los buffers a un archivo que se abre con
+ * chrome://tracing o https://ui.perfetto.dev. Mientras no se llame a enable()
+ * registrar una fase solo cuesta leer un flag.
+ */
+class Tracer
+{
+public:
+    /**
+     * @brief Activa el registro de eventos (llamar antes de lanzar los hilos)
+     */
+    static void enable();
+
+    /**
+     * @brief Indica si el registro está activo
+     */
+    static bool enabled();
+
+    /**
+     * @brief Asigna un nombre al hilo actual en la línea de tiempo
+     * @param name Nombre del hilo (p.ej. "worker 0")
+     */
+    static void set_thread_name(const std::string& name);
+
+    /**
+     * @brief Registra una fase completa del hilo actual
+     * @param name Nombre de la fase (debe ser un literal o vivir hasta write())
+     * @param start Inicio de la fase
+     * @param end Fin de la fase
+     * @param detail Texto opcional que se muestra como argumento del evento
+     */
+    static void record(const char* name, std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point end, const std::string& detail);
+
+    /**
+     * @brief Escribe todos los eventos registrados (llamar con los hilos ya terminados)
+     * @param path Archivo JSON de salida
+     * @return true si el archivo se escribió
+     */
+    static bool write(const std::string& path);
+};
+
+/**
+ * @brief Registra la fase que dura el alcance de este objeto
+ * Ejemplo: { TraceScope scope("insertion", "N=1024"); ... }
+ */
+class TraceScope
+{
+private:
+    const char* name;
+    std::string detail;
+    std::chrono::steady_clock::time_point start;
+    bool active;
+
+public:
+    TraceScope(const char* name, std::string detail = "")
+        : name(name), active(Tracer::enabled())
+    {
+        if (active) {
+            this->detail = std::move(detail);
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope()
+    {
+        if (active) Tracer::record(name, start, std::chrono::steady_clock::now(), detail);
+    }
+};
+
+#endif
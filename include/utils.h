@@ -8,12 +8,15 @@
 #include <queue>
 #include <cmath>
 
+#include "perf_counters.h"
+
 /**
  * @brief Estructura de argumentos para experimentos
  */
 struct arg
 {
-    unsigned int n; ///< Tamaño como potencia de 2 (log2)
+    unsigned int n;   ///< Tamaño como potencia de 2 (log2)
+    unsigned int rep; ///< Índice de la repetición (secuencia) para ese tamaño
 };
 
 /**
@@ -31,7 +34,7 @@ struct node
 struct edge
 {
     int u, v;           ///< Índices de nodos conectados
-    double weight;      ///< Peso de arista (distancia euclidiana al cuadrado)
+    double weight;      ///< Peso de arista (distancia según la métrica; por omisión euclidiana al cuadrado)
     
     /**
      * @brief Constructor con parámetros
@@ -83,13 +86,34 @@ struct datapoint
     std::string edge_extractor_name; ///< Nombre del extractor usado ("ArraySort" o "HeapMin")
     double time_insertion;          ///< Tiempo de inserción de aristas (segundos)
     bool opti_path;                 ///< Si se usó optimización path compression
+    unsigned int clusters = 0;      ///< k del modo k-clustering (0 = MST completo)
+    unsigned int seed = 0;          ///< Semilla del trabajo (columna Seed con --resume 1)
+    double merge_distance = 0.0;    ///< Peso de la última unión (distancia de corte en k-clustering)
     double time_kruskal;            ///< Tiempo de ejecución de Kruskal (segundos)
+    perf_sample perf_insertion;     ///< Contadores de hardware de la inserción
+    perf_sample perf_prepare;       ///< Contadores de hardware del ordenamiento/heapify
+    perf_sample perf_kruskal;       ///< Contadores de hardware del ciclo de Kruskal
+    unsigned long long edges_extracted;   ///< Aristas extraídas por Kruskal (KRUSKAL_STATS)
+    unsigned long long edges_accepted;    ///< Aristas aceptadas en el MST (KRUSKAL_STATS)
+    unsigned long long last_useful_edge;  ///< Posición de la última arista aceptada (KRUSKAL_STATS)
+    unsigned long long find_calls;        ///< Llamadas a find (KRUSKAL_STATS)
+    unsigned long long path_length_total; ///< Saltos totales recorridos por find (KRUSKAL_STATS)
+    unsigned long long path_length_max;   ///< Mayor número de saltos de un find (KRUSKAL_STATS)
+    unsigned long long compressions;      ///< Punteros reescritos por path compression (KRUSKAL_STATS)
+    long peak_rss_kb;                     ///< Memoria residente máxima del proceso (KB)
+    long long peak_heap_bytes;            ///< Máximo de memoria dinámica viva del hilo durante el experimento
+    long long extractor_bytes;            ///< Memoria retenida por el extractor tras la inserción
+    long long clone_bytes;                ///< Memoria retenida por el clon (0 si se usó el original)
+    unsigned long long result_bytes;      ///< Bytes asignados por kruskal() (resultado y Union-Find)
+    unsigned long long alloc_count;       ///< Asignaciones en inserción, clonación y Kruskal
 };
 
-// Función de distancia
+// Función de distancia (euclidiana al cuadrado; la misma que squared_l2 en metric.h)
 inline double distance(node a, node b)
 {
-    return std::pow(a.x - b.x, 2) + std::pow(a.y - b.y, 2);
+    const double dx = a.x - b.x;
+    const double dy = a.y - b.y;
+    return dx * dx + dy * dy;
 }
 
 
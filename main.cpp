@@ -7,82 +7,281 @@
 #include <thread>
 #include <mutex>
 #include <format>
-#include <condition_variable>
 #include <iomanip>
 #include <type_traits>
+#include <filesystem>
+#include <memory>
+#include <sstream>
 
 #include "include/utils.h"
 #include "include/edge_extractor.h"
 #include "include/kruskal.h"
+#include "include/config.h"
+#include "include/benchmark.h"
+#include "include/perf_counters.h"
+#include "include/tracer.h"
+#include "include/async_writer.h"
+#include "include/mem_tracker.h"
+#include "include/arena.h"
+#include "include/spatial_order.h"
+#include "include/edge_generation.h"
+#include "include/auto_extractor.h"
+#include "include/service.h"
+#include "include/checkpoint.h"
+
+// Sweep configuration (defaults in include/config.h, overridable from the command line)
+experiment_config config;
 
-const std::string NAME_DF = "resultados/df.csv";
-const std::string NAME_LOGS = "resultados/logs.txt";
-constexpr unsigned int LIMIT_SUBITER = 5;
-constexpr unsigned int SEED = 1234;
-constexpr unsigned int MAX_N_THREADS = 1; // Increased to 5 threads for better performance
-constexpr unsigned int LOG2_N_INIT = 5;
-constexpr unsigned int LOG2_N_END = 14;
-
-std::atomic<unsigned short> n_thread = 0;
 std::atomic<double> process_ready = 0.;
-bool ready = true;
 
 std::ofstream df, logs;
-std::mutex m_df, m_logs, m_ready;
-std::condition_variable cv;
+std::mutex m_queue;
+
+// Background writer: workers only enqueue pre-formatted records, the I/O
+// happens on the writer thread
+AsyncWriter writer(df, logs);
 
 std::vector<arg> queue_gen;
+BenchRecorder bench_recorder;
+// CPUs reserved to each worker: its pinning block and the threads of parallel
+// extractors, so that --threads workers never oversubscribe the machine
+unsigned int cpus_per_worker = 1;
+
+// Combinations already present in df.csv when resuming a sweep
+SweepCheckpoint checkpoint;
+
+// Per-thread scratch stream used to pre-format records without allocating each time
+std::ostringstream& thread_format_buffer()
+{
+    thread_local std::ostringstream buffer;
+    buffer.str("");
+    buffer.clear();
+    buffer << std::setprecision(10);
+    return buffer;
+}
 
 // Write the results in a file
-void safe_write_data_logs(const std::string txt)
+void safe_write_data_logs(const std::string& txt)
+{
+    std::ostringstream& line = thread_format_buffer();
+    line << txt << "\n";
+    writer.write(write_target::logs, line.view());
+}
+
+void safe_write_data_logs(const datapoint *data, const std::string& txt)
+{
+    std::ostringstream& line = thread_format_buffer();
+    line << "Experiment (N:" << data->n << "; EdgeExtractor: " << data->edge_extractor_name << "; optimization_path: " << data->opti_path << ") " << txt << "\n";
+    writer.write(write_target::logs, line.view());
+}
+
+// Header of df.csv; optional column groups are appended after the original ones
+std::string df_header()
 {
-    m_logs.lock();
-    logs << txt << "\n";
-    m_logs.unlock();
+    std::string header = "N,EdgeExtractorName,TimeInsertion,KruskalOptiPath,TimeKruskal";
+    if (config.perf_counters)
+    {
+        for (const std::string phase : {"Insertion", "Prepare", "Kruskal"})
+        {
+            for (const std::string& event : PERF_EVENT_NAMES) header += "," + phase + event;
+        }
+    }
+    if (config.memory_tracking)
+    {
+        header += ",PeakRSSKB,PeakHeapBytes,ExtractorBytes,CloneBytes,ResultBytes,AllocCount";
+    }
+    if (!config.clusters.empty())
+    {
+        header += ",Clusters,MergeDistance";
+    }
+    if (KRUSKAL_STATS_ENABLED)
+    {
+        header += ",EdgesExtracted,EdgesAccepted,LastUsefulEdge,FindCalls,PathLengthTotal,PathLengthMax,Compressions";
+    }
+    if (config.resume)
+    {
+        header += "," + SEED_COLUMN + "," + CONFIG_COLUMN;
+    }
+    return header;
 }
 
-void safe_write_data_logs(const datapoint *data, const std::string txt)
+// Unavailable counters are written as empty fields
+void write_perf_columns(std::ostream& out, const perf_sample& sample)
 {
-    m_logs.lock();
-    logs << "Experiment (N:" << data->n << "; EdgeExtractor: " << data->edge_extractor_name << "; optimization_path: " << data->opti_path << ") " << txt << "\n";
-    m_logs.unlock();
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    {
+        out << ",";
+        if (sample.valid[i]) out << sample.value[i];
+    }
 }
 
 void safe_write_datapoint(const datapoint *data)
 {
-    m_df.lock();
-    df <<  data->n << "," << data->edge_extractor_name << "," << data->time_insertion << "," << data->opti_path << "," << data->time_kruskal << "\n";
-    m_df.unlock();
+    std::ostringstream& row = thread_format_buffer();
+    row <<  data->n << "," << data->edge_extractor_name << "," << data->time_insertion << "," << data->opti_path << "," << data->time_kruskal;
+    if (config.perf_counters)
+    {
+        write_perf_columns(row, data->perf_insertion);
+        write_perf_columns(row, data->perf_prepare);
+        write_perf_columns(row, data->perf_kruskal);
+    }
+    if (config.memory_tracking)
+    {
+        row << "," << data->peak_rss_kb << "," << data->peak_heap_bytes << "," << data->extractor_bytes
+            << "," << data->clone_bytes << "," << data->result_bytes << "," << data->alloc_count;
+    }
+    if (!config.clusters.empty())
+    {
+        row << "," << data->clusters << "," << data->merge_distance;
+    }
+    if (KRUSKAL_STATS_ENABLED)
+    {
+        row << "," << data->edges_extracted << "," << data->edges_accepted << "," << data->last_useful_edge
+           << "," << data->find_calls << "," << data->path_length_total << "," << data->path_length_max
+           << "," << data->compressions;
+    }
+    if (config.resume)
+    {
+        static const std::string fingerprint = config_fingerprint(config);
+        row << "," << data->seed << "," << fingerprint;
+    }
+    row << "\n";
+    writer.write(write_target::df, row.view());
+}
+
+// Hardware counters of the calling worker; nullptr when disabled or unavailable
+PerfCounters* thread_perf_counters()
+{
+    thread_local std::unique_ptr<PerfCounters> counters;
+    thread_local bool initialized = false;
+    if (!config.perf_counters) return nullptr;
+    if (!initialized)
+    {
+        initialized = true;
+        counters = std::make_unique<PerfCounters>();
+        if (!counters->available())
+        {
+            safe_write_data_logs("Perf events no disponibles en este hilo: las columnas de contadores quedan vacías");
+            counters.reset();
+        }
+    }
+    return counters.get();
+}
+
+// Run one phase under the worker's hardware counters (when enabled) and time it
+template <typename Phase>
+double measure_phase(perf_sample& sample, Phase&& phase)
+{
+    PerfCounters* counters = thread_perf_counters();
+    if (counters) counters->start();
+    auto start = std::chrono::high_resolution_clock::now();
+    phase();
+    auto end = std::chrono::high_resolution_clock::now();
+    if (counters) sample = counters->stop();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// Allocation counters of this worker: operator new (mem_tracker) plus what the
+// arena served from mmap, so --alloc arena|huge keeps the memory columns meaningful.
+// The peak is the sum of both peaks, an upper bound on the combined peak
+alloc_snapshot experiment_allocations()
+{
+    alloc_snapshot total = thread_allocations();
+    const alloc_snapshot arena = thread_arena().allocations();
+    total.count += arena.count;
+    total.bytes += arena.bytes;
+    total.live_bytes += arena.live_bytes;
+    total.peak_live_bytes += arena.peak_live_bytes;
+    return total;
+}
+
+// Restarts the peak of both counters that experiment_allocations() adds up
+void reset_experiment_peak()
+{
+    reset_thread_peak();
+    thread_arena().reset_peak();
 }
 
-void experiment(EdgeExtractor* edge_extractor, const double time_insertion, const bool is_opt)
+void experiment(EdgeExtractor* edge_extractor, const datapoint& insertion, const bool is_opt, const unsigned int clusters, const arg& job, const unsigned int run, const std::vector<int>& original_ids)
 {
     // Generate the data for the experiment
     struct datapoint* datapoint = new struct datapoint;
 
-    // Calculate number of nodes from number of edges (for complete graph: edges = n*(n-1)/2)
-    size_t num_aristas = edge_extractor->size();
-    int num_nodos = static_cast<int>((1 + std::sqrt(1 + 8.0 * num_aristas)) / 2.0);
+    // Number of nodes comes from the job: with radius-bounded generation the
+    // edge count no longer matches a complete graph
+    int num_nodos = 1 << job.n;
     
     datapoint->n = num_nodos;  // Store number of nodes, not edges
     datapoint->edge_extractor_name = edge_extractor->get_name();
     datapoint->opti_path = is_opt;
-    datapoint->time_insertion = time_insertion;
+    datapoint->clusters = clusters;
+    datapoint->seed = job_seed(config, job.n, job.rep);
+    datapoint->time_insertion = insertion.time_insertion;
+    datapoint->perf_insertion = insertion.perf_insertion;
+    datapoint->extractor_bytes = insertion.extractor_bytes;
+    datapoint->clone_bytes = insertion.clone_bytes;
 
     // Run Kruskal algorithm
     safe_write_data_logs(datapoint, "Run Kruskal algorithm...\n");
 
-    auto start_exp = std::chrono::high_resolution_clock::now(); // time initial insert
-    void* kruskal_result = kruskal(edge_extractor, is_opt);
-    auto end_exp = std::chrono::high_resolution_clock::now(); // time end insert
-    std::chrono::duration<double> delta_time_exp = end_exp - start_exp;
-
-    datapoint->time_kruskal = delta_time_exp.count();
+    // Sort/heapify and the union-find loop are measured as separate phases;
+    // TimeKruskal keeps covering both
+    void* kruskal_result = nullptr;
+    const std::string trace_detail = std::format("N={} {} opti_path={}", num_nodos, datapoint->edge_extractor_name, is_opt);
+    // prepare() may build working buffers (ArraySort's keys, indices and sort
+    // scratch): its peak on top of the inserted edges counts as extractor memory
+    const alloc_snapshot before_prepare = experiment_allocations();
+    reset_experiment_peak();
+    double time_prepare = measure_phase(datapoint->perf_prepare, [&]() {
+        TraceScope scope("sort/heapify", trace_detail);
+        edge_extractor->prepare();
+    });
+    datapoint->extractor_bytes += experiment_allocations().peak_live_bytes - before_prepare.live_bytes;
+    alloc_snapshot before_kruskal;
+    alloc_snapshot after_kruskal;
+    double time_loop = measure_phase(datapoint->perf_kruskal, [&]() {
+        TraceScope scope("union-find loop", trace_detail);
+        before_kruskal = experiment_allocations();
+        kruskal_result = kruskal(edge_extractor, is_opt, kruskal_options{config.kruskal_batch, num_nodos, config.reconstruction_tree, static_cast<int>(clusters)});
+        after_kruskal = experiment_allocations();
+    });
+
+    datapoint->time_kruskal = time_prepare + time_loop;
+    datapoint->merge_distance = get_merge_distance(kruskal_result);
+
+    // Keep the way back to generation-order ids when the vertices were renumbered
+    set_vertex_mapping(kruskal_result, original_ids);
+
+    kruskal_stats stats = get_kruskal_stats(kruskal_result);
+    datapoint->edges_extracted = stats.edges_extracted;
+    datapoint->edges_accepted = stats.edges_accepted;
+    datapoint->last_useful_edge = stats.last_useful_edge;
+    datapoint->find_calls = stats.find_calls;
+    datapoint->path_length_total = stats.path_length_total;
+    datapoint->path_length_max = stats.path_length_max;
+    datapoint->compressions = stats.compressions;
+
+    // Memory: bytes allocated by kruskal() (result + union-find), allocation
+    // count of insertion + clone + Kruskal, worker heap peak and process peak RSS
+    datapoint->result_bytes = after_kruskal.bytes - before_kruskal.bytes;
+    datapoint->alloc_count = insertion.alloc_count + (after_kruskal.count - before_kruskal.count);
+    datapoint->peak_heap_bytes = std::max(before_prepare.peak_live_bytes, experiment_allocations().peak_live_bytes);
+    datapoint->peak_rss_kb = peak_rss_kb();
 
     // Clean up the result
     free_kruskal_result(kruskal_result);
 
-    safe_write_datapoint(datapoint);
+    {
+        TraceScope scope("result write", trace_detail);
+        if (config.bench_mode)
+        {
+            bench_recorder.add({*datapoint, job.rep, run, run < config.warmup_runs});
+        }
+        else
+        {
+            safe_write_datapoint(datapoint);
+        }
+    }
 
     safe_write_data_logs(datapoint, "Ready!");
     
@@ -92,36 +291,97 @@ void experiment(EdgeExtractor* edge_extractor, const double time_insertion, cons
 }
 
 
-void main_experiment(EdgeExtractor* edge_extractor, const std::vector<edge>& array_edges)
+void main_experiment(EdgeExtractor* edge_extractor, const edge_vector& array_edges, const arg& job, const unsigned int run, const std::vector<int>& original_ids, const std::vector<std::pair<bool, unsigned int>>& runs)
 {
     // Insert all edges from array_edges to edge extractor object
     std::string txt_init = std::format("Insertion Initialized...\nInsert {} edges en {}...\n", array_edges.size(), edge_extractor->get_name());
     safe_write_data_logs(txt_init);
 
-    auto start_insert = std::chrono::high_resolution_clock::now(); // time initial insert
-    for (const edge& e : array_edges){edge_extractor->insert_edge(e);}
-    auto end_insert = std::chrono::high_resolution_clock::now(); // time end insert
-    
+    // With a single worker the process peak RSS can be attributed to this experiment
+    if (config.memory_tracking && config.max_threads == 1) reset_peak_rss();
+    reset_experiment_peak();
+
+    datapoint insertion;
+    alloc_snapshot before_insert = experiment_allocations();
+    // With the arena the final size is reserved up front: the storage comes
+    // from pages already mapped by earlier jobs and is never regrown. It runs
+    // before the timer, so a first-use mmap + prefault stays out of TimeInsertion
+    if (thread_arena().enabled())
+    {
+        TraceScope scope("reserve", edge_extractor->get_name());
+        edge_extractor->reserve(array_edges.size());
+    }
+    insertion.time_insertion = measure_phase(insertion.perf_insertion, [&]() {
+        TraceScope scope("insertion", std::format("{} edges {}", array_edges.size(), edge_extractor->get_name()));
+        for (const edge& e : array_edges){edge_extractor->insert_edge(e);}
+    });
+    alloc_snapshot after_insert = experiment_allocations();
+    insertion.extractor_bytes = after_insert.live_bytes - before_insert.live_bytes;
+    insertion.alloc_count = after_insert.count - before_insert.count;
 
     std::string txt_end = std::format("Insertion Finished! \nInsert {} edges en {}...\n", array_edges.size(), edge_extractor->get_name());
     safe_write_data_logs(txt_end);
 
-    std::chrono::duration<double> delta_time_insert = end_insert - start_insert;
-    // Create a new edge extractor object
-    EdgeExtractor* edge_extractor2 = edge_extractor->clone(); // Duplicate edge extractor object
+    // Run Kruskal once per pending (union-find policy, k) pair; every run but
+    // the last works on a clone, so all of them start from the same inserted state
+    for (size_t i = 0; i + 1 < runs.size(); ++i)
+    {
+        EdgeExtractor* edge_extractor_clone;
+        alloc_snapshot before_clone = experiment_allocations();
+        {
+            TraceScope scope("clone", edge_extractor->get_name());
+            edge_extractor_clone = edge_extractor->clone(); // Duplicate edge extractor object
+        }
+        alloc_snapshot after_clone = experiment_allocations();
 
-    // Run the Kruskal algorithm on both edge extractor objects
-    experiment(edge_extractor, delta_time_insert.count(), true);
-    experiment(edge_extractor2, delta_time_insert.count(), false);
+        datapoint insertion_clone = insertion;
+        insertion_clone.clone_bytes = after_clone.live_bytes - before_clone.live_bytes;
+        insertion_clone.alloc_count += after_clone.count - before_clone.count;
+        experiment(edge_extractor_clone, insertion_clone, runs[i].first, runs[i].second, job, run, original_ids);
+        delete edge_extractor_clone;
+    }
+    insertion.clone_bytes = 0;
+    experiment(edge_extractor, insertion, runs.back().first, runs.back().second, job, run, original_ids);
 
     // Free memory
     delete edge_extractor;
-    delete edge_extractor2;
 }
 
 
+// (opti_path, k) pairs of one extractor still missing from df.csv; all of them
+// unless resuming
+std::vector<std::pair<bool, unsigned int>> pending_runs(const std::string& extractor_name, const arg& job, unsigned int seed)
+{
+    const std::vector<unsigned int> clusters = config.clusters.empty() ? std::vector<unsigned int>{0} : config.clusters;
+    std::vector<std::pair<bool, unsigned int>> runs;
+    for (bool opti_path : config.opti_paths)
+    {
+        for (unsigned int k : clusters)
+        {
+            if (config.resume && checkpoint.done(1ull << job.n, seed, extractor_name, opti_path, k)) continue;
+            runs.emplace_back(opti_path, k);
+        }
+    }
+    return runs;
+}
+
 void main_thread(const arg data, unsigned int thread_seed)
 {
+    // Work out what is left of this job before generating anything
+    std::vector<std::vector<std::pair<bool, unsigned int>>> runs_per_extractor;
+    bool pending = false;
+    for (const std::string& extractor_name : config.extractors)
+    {
+        runs_per_extractor.push_back(pending_runs(extractor_name, data, thread_seed));
+        pending |= !runs_per_extractor.back().empty();
+    }
+    if (!pending)
+    {
+        safe_write_data_logs(std::format("N={} repetición {}: ya completado en {}, se salta", (1<<data.n), data.rep, config.df_path));
+        process_ready += 1. / (config.repetitions * (config.log2_n_end - config.log2_n_init + 1));
+        return;
+    }
+
     std::vector<node> array_nodes;
     std::uniform_real_distribution<double> distrib(0.0, 1.0);
     
@@ -135,95 +395,196 @@ void main_thread(const arg data, unsigned int thread_seed)
     // Reserve space in memory
     array_nodes.reserve(1 << data.n);
 
-    // Generate random nodes
-    for (size_t i = 0; i < array_nodes.capacity(); ++i)
+    // Generate random nodes, or read them back from the input cache
     {
-        array_nodes.push_back({distrib(gen), distrib(gen)});
+        TraceScope scope("point generation", std::format("N={}", (1<<data.n)));
+        if (config.input_cache.empty() || !load_cached_points(config.input_cache, data.n, thread_seed, array_nodes))
+        {
+            for (size_t i = 0; i < array_nodes.capacity(); ++i)
+            {
+                array_nodes.push_back({distrib(gen), distrib(gen)});
+            }
+            if (!config.input_cache.empty() && !store_cached_points(config.input_cache, data.n, thread_seed, array_nodes))
+            {
+                safe_write_data_logs(std::format("N={}: no se pudieron guardar los puntos en {}", (1<<data.n), config.input_cache));
+            }
+        }
     }
 
-    // Calculate the distance between each pair of nodes
-    // and save it in a vector of edges
-    std::vector<edge> array_edges;
-    array_edges.reserve(array_nodes.size() * (array_nodes.size() - 1) / 2);
-    
-    for (size_t i = 0; i < array_nodes.size(); ++i)
+    // Optionally renumber the points along a space-filling curve so that nearby
+    // points get nearby ids (better union-find locality); original_ids maps back
+    std::vector<int> original_ids;
+    if (config.order != vertex_order::generation)
     {
-        for (size_t j = i + 1; j < array_nodes.size(); ++j)
-        {
-            double weight = distance(array_nodes[i], array_nodes[j]);
-            array_edges.emplace_back(static_cast<int>(i), static_cast<int>(j), weight);
-        }
+        TraceScope scope("vertex reorder", std::format("N={}", (1<<data.n)));
+        original_ids = reorder_vertices(array_nodes, config.order);
+    }
+
+    // Calculate the distance between each pair of nodes and save it in a vector
+    // of edges; radius mode keeps only the short pairs, growing the threshold
+    // until they connect every node so the MST stays exact. The metric is picked
+    // once here; the generators are instantiated per metric policy
+    edge_vector array_edges;
+    {
+        TraceScope scope("edge generation", std::format("N={}", (1<<data.n)));
+        with_metric(config.metric, [&](auto metric) {
+            using Metric = decltype(metric);
+            if (config.edges == edge_mode::radius)
+            {
+                radius_generation generation = generate_spanning_radius_edges<Metric>(array_nodes, config.radius_c, array_edges);
+                safe_write_data_logs(std::format("N={}: {} edges with weight <= {} ({} attempts)",
+                                                 (1<<data.n), array_edges.size(), generation.threshold, generation.attempts));
+            }
+            else
+            {
+                generate_complete_edges<Metric>(array_nodes, array_edges);
+            }
+        });
     }
 
     // Delete the vector
     array_nodes.clear();
 
-    ArraySort* array_sort = new ArraySort();
-    HeapMin* heap_min = new HeapMin();
-    
-    // Run the experiment
-    main_experiment(array_sort, array_edges);
-    main_experiment(heap_min, array_edges);
-    n_thread--;
-    ready = true;
-    cv.notify_one();
-    process_ready += 1. / (LIMIT_SUBITER * (LOG2_N_END - LOG2_N_INIT + 1));
+    // Run the experiment; benchmark mode repeats it on the same input, the first
+    // warmup_runs runs being discarded from the statistics
+    const unsigned int total_runs = config.bench_mode ? config.warmup_runs + config.measure_runs : 1;
+
+    // What the Auto extractor's cost model needs to know about this job
+    extraction_hint hint;
+    hint.num_edges = array_edges.size();
+    hint.consumed_fraction = estimate_consumed_fraction(size_t(1) << data.n, array_edges.size());
+    hint.threads = cpus_per_worker;
+
+    for (size_t e = 0; e < config.extractors.size(); ++e)
+    {
+        if (runs_per_extractor[e].empty()) continue;
+        for (unsigned int run = 0; run < total_runs; ++run)
+        {
+            main_experiment(make_edge_extractor(config.extractors[e], hint, config.cost_model_path), array_edges, data, run, original_ids, runs_per_extractor[e]);
+        }
+    }
+    process_ready += 1. / (config.repetitions * (config.log2_n_end - config.log2_n_init + 1));
     std::cout << "\n Porcentaje de la tarea:" << process_ready*100 << "%;\n";
 }
 
-int main()
+void worker(const unsigned int worker_id, const bool pin)
+{
+    Tracer::set_thread_name(std::format("worker {}", worker_id));
+    // Per-worker arena for the edge arrays, reused by every job of this worker
+    thread_arena().configure(config.allocator, config.prefault);
+    if (pin && !pin_current_thread(worker_id, cpus_per_worker))
+    {
+        safe_write_data_logs(std::format("Worker {}: no se pudo fijar la afinidad de CPU", worker_id));
+    }
+
+    while (true)
+    {
+        arg data_experiment;
+        {
+            std::lock_guard lock(m_queue);
+            if (queue_gen.empty()) return;
+            data_experiment = queue_gen.back();
+            queue_gen.pop_back();
+        }
+
+        // Seed depends only on (seed, N, repetition): reproducible for any thread count
+        unsigned int thread_seed = job_seed(config, data_experiment.n, data_experiment.rep);
+        main_thread(data_experiment, thread_seed);
+    }
+}
+
+int main(int argc, char** argv)
 {
+    if (!parse_config(argc, argv, config))
+    {
+        return 1;
+    }
+
+    // Service mode answers requests on stdin/stdout or a Unix socket instead of
+    // running the sweep; stdout is left to the protocol
+    if (!config.serve.empty())
+    {
+        set_sort_kernel(config.array_sort);
+        return run_service(config);
+    }
+
     std::cout << "Iniciando el programa...\n";
     std::cin.tie(nullptr);
     std::ios_base::sync_with_stdio(false);
 
-    df.open(NAME_DF, std::ios::out);
-    logs.open(NAME_LOGS, std::ios::out);
-
-    df << std::setprecision(10);
-    std::cout << "Iniciando el csv..."<< std::endl;
-    df << "N,EdgeExtractorName,TimeInsertion,KruskalOptiPath,TimeKruskal\n";
-    std::cout << "Inicializado el csv!"<< std::endl;
-
-    std::mt19937 gen(SEED); // Generator
+    for (const std::string& path : {config.df_path, config.logs_path, config.bench_runs_path, config.bench_summary_path, config.trace_path})
+    {
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+    }
+    // A resumed sweep keeps the log of the interrupted run too
+    logs.open(config.logs_path, config.resume ? std::ios::out | std::ios::app : std::ios::out);
 
-    std::vector<std::jthread> list_threads;
-    std::cout << "Iniciando los experimentos..."<< std::endl;
-    for (unsigned int i = LOG2_N_INIT; i < (LOG2_N_END + 1); i++)
+    // Benchmark mode writes its own CSVs and leaves df.csv untouched
+    if (config.resume)
     {
-        for (unsigned int j = LIMIT_SUBITER; j > 0; j--)
+        // Keep the rows of a previous (possibly interrupted) run and append to them
+        std::string error;
+        if (!checkpoint.load(config.df_path, df_header(), config_fingerprint(config), error))
         {
-            queue_gen.push_back({i});
+            std::cerr << "Error: no se puede reanudar: " << error << std::endl;
+            return 1;
         }
+        std::cout << "Reanudando " << config.df_path << ": " << checkpoint.size() << " combinaciones ya completadas" << std::endl;
+        std::error_code ec;
+        const bool empty = !std::filesystem::exists(config.df_path, ec) || std::filesystem::file_size(config.df_path, ec) == 0;
+        df.open(config.df_path, std::ios::out | std::ios::app);
+        df << std::setprecision(10);
+        if (empty) df << df_header() << "\n" << std::flush;
+    }
+    else if (!config.bench_mode)
+    {
+        df.open(config.df_path, std::ios::out);
+        df << std::setprecision(10);
+        std::cout << "Iniciando el csv..."<< std::endl;
+        df << df_header() << "\n";
+        std::cout << "Inicializado el csv!"<< std::endl;
     }
 
-    unsigned int thread_counter = 0;
-    while (!queue_gen.empty())
+    std::cout << "Iniciando los experimentos..."<< std::endl;
+    for (unsigned int i = config.log2_n_init; i < (config.log2_n_end + 1); i++)
     {
-        if (n_thread < MAX_N_THREADS)
+        for (unsigned int j = config.repetitions; j > 0; j--)
         {
-            n_thread++;
-            arg data_experiment = queue_gen.back();
-            queue_gen.pop_back();
-            
-            // Generate unique seed for each thread
-            unsigned int thread_seed = SEED + thread_counter * 1000 + data_experiment.n;
-            thread_counter++;
-            
-            std::jthread work(main_thread, data_experiment, thread_seed);
-            list_threads.push_back(std::move(work));
-        }
-        else
-        {
-            {
-                ready = false;
-                std::unique_lock lk(m_ready);
-                cv.wait(lk, []
-                        { return ready; });
-            }
+            queue_gen.push_back({i, j - 1});
         }
     }
 
+    if (!config.trace_path.empty())
+    {
+        Tracer::enable();
+    }
+
+    // ArraySort's sort path is process-wide; an unsupported kernel falls back to std
+    set_sort_kernel(config.array_sort);
+    std::cout << "Kernel de ordenamiento de ArraySort: " << sort_kernel_name(active_sort_kernel()) << std::endl;
+
+    // Load or calibrate the Auto cost model before the workers start, so the
+    // calibration run does not compete with measured experiments
+    if (std::find(config.extractors.begin(), config.extractors.end(), AUTO_EXTRACTOR_NAME) != config.extractors.end())
+    {
+        std::cout << "Cargando modelo de costo de " << config.cost_model_path << " (se calibra si no existe)..." << std::endl;
+        shared_cost_model(config.cost_model_path);
+    }
+
+    writer.start();
+
+    // Fixed pool of workers pulling jobs from the queue; a stable worker id
+    // lets each worker stay pinned to the same CPUs across jobs
+    const bool pin = config.pin_threads == 1 || (config.pin_threads == -1 && config.bench_mode);
+    const unsigned int n_workers = std::min<size_t>(config.max_threads, queue_gen.size());
+    cpus_per_worker = std::max(1u, available_cpus() / std::max(1u, n_workers));
+    std::vector<std::jthread> list_threads;
+    for (unsigned int worker_id = 0; worker_id < n_workers; ++worker_id)
+    {
+        list_threads.emplace_back(worker, worker_id, pin);
+    }
+
     // Wait for all threads to complete before closing files
     std::cout << "Esperando que terminen todos los threads..." << std::endl;
     for (auto& thread : list_threads) {
@@ -232,6 +593,26 @@ int main()
         }
     }
     
+    writer.stop();
+
+    if (config.bench_mode)
+    {
+        if (!bench_recorder.write(config.bench_runs_path, config.bench_summary_path, !config.clusters.empty()))
+        {
+            std::cerr << "Error: no se pudieron escribir los resultados del benchmark" << std::endl;
+        }
+        std::cout << "Benchmark guardado en " << config.bench_runs_path << " y " << config.bench_summary_path << std::endl;
+    }
+
+    if (Tracer::enabled())
+    {
+        if (!Tracer::write(config.trace_path))
+        {
+            std::cerr << "Error: no se pudo escribir la traza en " << config.trace_path << std::endl;
+        }
+        std::cout << "Traza guardada en " << config.trace_path << std::endl;
+    }
+
     std::cout << "Todos los threads completados. Cerrando archivos..." << std::endl;
     df.close();
     logs.close();
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../include/arena.h"
+
+namespace {
+
+size_t round_up(size_t value, size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+Arena::chunk Arena::map_chunk(size_t bytes)
+{
+    const size_t capacity = round_up(std::max(bytes, MIN_CHUNK_BYTES), HUGE_PAGE_BYTES);
+    char* base = nullptr;
+
+    if (mode == arena_mode::huge) {
+        // Primero páginas grandes reservadas (hugetlbfs); si el pool está vacío,
+        // páginas grandes transparentes sobre un bloque alineado a 2 MB
+        void* p = mmap(nullptr, capacity, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            base = static_cast<char*>(p);
+        } else {
+            p = mmap(nullptr, capacity + HUGE_PAGE_BYTES, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) throw std::bad_alloc();
+            char* raw = static_cast<char*>(p);
+            char* aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(raw), HUGE_PAGE_BYTES));
+            // Devolver los bordes que sobran antes y después del bloque alineado
+            if (aligned > raw) munmap(raw, aligned - raw);
+            size_t tail = (raw + capacity + HUGE_PAGE_BYTES) - (aligned + capacity);
+            if (tail > 0) munmap(aligned + capacity, tail);
+            madvise(aligned, capacity, MADV_HUGEPAGE);
+            base = aligned;
+        }
+    } else {
+        void* p = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        base = static_cast<char*>(p);
+    }
+
+    if (prefault) {
+        // Tocar cada página para que los page faults ocurran ahora y no al insertar
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        for (size_t offset = 0; offset < capacity; offset += page) {
+            base[offset] = 0;
+        }
+    }
+    return {base, capacity, 0};
+}
+
+void Arena::unmap_chunk(const chunk& c)
+{
+    munmap(c.base, c.capacity);
+}
+
+void Arena::rewind()
+{
+    // Si el trabajo necesitó varios bloques, se juntan en uno del tamaño total
+    // para que el siguiente trabajo del mismo tamaño quepa en un solo bloque
+    if (chunks.size() > 1) {
+        size_t total = 0;
+        for (const chunk& c : chunks) {
+            total += c.capacity;
+            unmap_chunk(c);
+        }
+        chunks.clear();
+        chunks.push_back(map_chunk(total));
+    }
+    for (chunk& c : chunks) c.used = 0;
+}
+
+void Arena::configure(arena_mode new_mode, bool new_prefault)
+{
+    if (new_mode != mode) {
+        for (const chunk& c : chunks) unmap_chunk(c);
+        chunks.clear();
+        live = 0;
+        counters.live_bytes = 0;
+    }
+    mode = new_mode;
+    prefault = new_prefault;
+}
+
+void* Arena::allocate(size_t bytes, size_t align)
+{
+    counters.count++;
+    counters.bytes += bytes;
+    counters.live_bytes += bytes;
+    counters.peak_live_bytes = std::max(counters.peak_live_bytes, counters.live_bytes);
+    if (bytes == 0) bytes = 1;
+    for (chunk& c : chunks) {
+        size_t start = round_up(c.used, align);
+        if (start + bytes <= c.capacity) {
+            c.used = start + bytes;
+            live++;
+            return c.base + start;
+        }
+    }
+    chunks.push_back(map_chunk(bytes));
+    chunk& c = chunks.back();
+    c.used = bytes;
+    live++;
+    return c.base;
+}
+
+bool Arena::deallocate(void* ptr, size_t bytes)
+{
+    char* p = static_cast<char*>(ptr);
+    for (chunk& c : chunks) {
+        if (p < c.base || p >= c.base + c.capacity) continue;
+
+        counters.live_bytes -= bytes;
+        // La última asignación de un bloque se puede devolver de inmediato
+        if (p + bytes == c.base + c.used) c.used = p - c.base;
+        if (--live == 0) rewind();
+        return true;
+    }
+    return false;
+}
+
+size_t Arena::mapped_bytes() const
+{
+    size_t total = 0;
+    for (const chunk& c : chunks) total += c.capacity;
+    return total;
+}
+
+Arena::~Arena()
+{
+    for (const chunk& c : chunks) unmap_chunk(c);
+}
+
+Arena& thread_arena()
+{
+    thread_local Arena arena;
+    return arena;
+}
+
+bool parse_arena_mode(const std::string& name, arena_mode& mode)
+{
+    if (name == "system") { mode = arena_mode::system; return true; }
+    if (name == "arena") { mode = arena_mode::arena; return true; }
+    if (name == "huge") { mode = arena_mode::huge; return true; }
+    return false;
+}
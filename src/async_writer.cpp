@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "../include/async_writer.h"
+
+AsyncWriter::AsyncWriter(std::ostream& df, std::ostream& logs) : df(df), logs(logs) {}
+
+AsyncWriter::ring& AsyncWriter::current_ring()
+{
+    // Un ring por hilo y por escritor; se registra una sola vez (único lock del productor)
+    thread_local std::shared_ptr<ring> local_ring;
+    thread_local AsyncWriter* owner = nullptr;
+    if (!local_ring || owner != this) {
+        local_ring = std::make_shared<ring>();
+        owner = this;
+        std::lock_guard lock(m_rings);
+        rings.push_back(local_ring);
+    }
+    return *local_ring;
+}
+
+void AsyncWriter::write(write_target target, std::string_view text)
+{
+    constexpr size_t chunk = sizeof(record::text);
+    size_t parts = std::max<size_t>(1, (text.size() + chunk - 1) / chunk);
+    if (parts > MAX_RECORDS_PER_MESSAGE) {
+        parts = MAX_RECORDS_PER_MESSAGE;
+        text = text.substr(0, parts * chunk);
+    }
+
+    ring& r = current_ring();
+    const size_t head = r.head.load(std::memory_order_relaxed);
+
+    // Esperar espacio para el mensaje completo: se publica de una vez para que
+    // el consumidor nunca vea un mensaje a medias
+    while (head + parts - r.tail.load(std::memory_order_acquire) > RING_RECORDS) {
+        std::this_thread::yield();
+    }
+
+    for (size_t i = 0; i < parts; ++i) {
+        record& rec = r.records[(head + i) & (RING_RECORDS - 1)];
+        std::string_view piece = text.substr(i * chunk, chunk);
+        rec.target = target;
+        rec.length = static_cast<unsigned short>(piece.size());
+        std::memcpy(rec.text, piece.data(), piece.size());
+    }
+    r.head.store(head + parts, std::memory_order_release);
+}
+
+size_t AsyncWriter::drain()
+{
+    std::vector<std::shared_ptr<ring>> snapshot;
+    {
+        std::lock_guard lock(m_rings);
+        snapshot = rings;
+    }
+
+    size_t drained = 0;
+    bool wrote_df = false;
+    for (const auto& r : snapshot) {
+        const size_t tail = r->tail.load(std::memory_order_relaxed);
+        const size_t head = r->head.load(std::memory_order_acquire);
+        for (size_t pos = tail; pos < head; ++pos) {
+            const record& rec = r->records[pos & (RING_RECORDS - 1)];
+            std::ostream& out = rec.target == write_target::df ? df : logs;
+            out.write(rec.text, rec.length);
+            wrote_df |= rec.target == write_target::df;
+        }
+        r->tail.store(head, std::memory_order_release);
+        drained += head - tail;
+    }
+    // Las filas llegan al sistema operativo apenas se escriben: si el proceso
+    // muere (crash, Ctrl+C) solo se pierden los experimentos sin terminar
+    if (wrote_df) df.flush();
+    return drained;
+}
+
+void AsyncWriter::run()
+{
+    while (running.load(std::memory_order_acquire)) {
+        if (drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void AsyncWriter::start()
+{
+    running = true;
+    writer_thread = std::thread(&AsyncWriter::run, this);
+}
+
+void AsyncWriter::stop()
+{
+    if (!running.exchange(false)) return;
+    writer_thread.join();
+    drain();
+    df.flush();
+    logs.flush();
+}
+
+AsyncWriter::~AsyncWriter()
+{
+    stop();
+}
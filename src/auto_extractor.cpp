@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "../include/auto_extractor.h"
+
+namespace {
+
+/**
+ * @brief Extractor que el modelo puede elegir, con lo que no se mide en la calibración
+ */
+struct candidate
+{
+    std::string name;
+    double bytes_per_edge;
+    bool parallel;
+};
+
+const std::vector<candidate> CANDIDATES = {
+    {"ArraySort", sizeof(edge) + 24, false}, // Claves, índices y sus copias del kernel de ordenamiento
+    {"HeapMin", sizeof(edge), false},
+    {"RunMerge", sizeof(edge), true},
+    {"SequenceHeap", 2 * sizeof(edge), false}, // Una mezcla de grupo copia las secuencias
+};
+
+const std::string COST_MODEL_HEADER =
+    "Extractor,InsertBaseNs,InsertLogNs,PrepareSerialNs,ExtractBaseNs,ExtractLogNs,BytesPerEdge,Parallel";
+
+constexpr unsigned int MIN_CALIBRATION_LOG2 = 12;
+constexpr unsigned int CALIBRATION_REPS = 3;
+
+double log2_edges(size_t m)
+{
+    return std::log2(static_cast<double>(std::max<size_t>(m, 2)));
+}
+
+/**
+ * @brief Ajuste por mínimos cuadrados de y = a + b·x
+ */
+void fit_line(const std::vector<double>& x, const std::vector<double>& y, double& a, double& b)
+{
+    const double n = static_cast<double>(x.size());
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sx += x[i];
+        sy += y[i];
+        sxx += x[i] * x[i];
+        sxy += x[i] * y[i];
+    }
+    const double denom = n * sxx - sx * sx;
+    b = denom != 0 ? (n * sxy - sx * sy) / denom : 0.0;
+    a = (sy - b * sx) / n;
+}
+
+/**
+ * @brief Ajuste por mínimos cuadrados de y = c·x (recta por el origen)
+ */
+double fit_through_origin(const std::vector<double>& x, const std::vector<double>& y)
+{
+    double sxx = 0, sxy = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sxx += x[i] * x[i];
+        sxy += x[i] * y[i];
+    }
+    return sxx > 0 ? sxy / sxx : 0.0;
+}
+
+double median_of(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+double elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+double estimate_consumed_fraction(size_t num_nodes, size_t num_edges)
+{
+    if (num_nodes < 2 || num_edges == 0) return 1.0;
+    double expected = num_nodes * std::log(static_cast<double>(num_nodes));
+    return std::clamp(expected / num_edges, 1.0 / num_edges, 1.0);
+}
+
+size_t available_memory_bytes()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line)) {
+        if (line.rfind("MemAvailable:", 0) == 0) return std::stoull(line.substr(13)) * 1024;
+    }
+    return 0;
+}
+
+double predict_cost_ns(const extractor_cost& cost, const extraction_hint& hint)
+{
+    const double m = static_cast<double>(hint.num_edges);
+    const double lg = log2_edges(hint.num_edges);
+    const double k = hint.consumed_fraction * m;
+    double prepare = cost.prepare * m * lg;
+    if (cost.parallel) {
+        unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+        prepare /= std::max(1u, std::min(hint.threads, cores));
+    }
+    // Los ajustes lineales pueden extrapolar a costos negativos fuera del rango calibrado
+    const double insert_per_edge = std::max(0.0, cost.insert_base + cost.insert_log * lg);
+    const double extract_per_edge = std::max(0.0, cost.extract_base + cost.extract_log * lg);
+    return m * insert_per_edge + prepare + k * extract_per_edge;
+}
+
+std::string choose_extractor(const cost_model& model, const extraction_hint& hint)
+{
+    const double memory = hint.available_bytes > 0 ? hint.available_bytes : available_memory_bytes();
+    const extractor_cost* best = nullptr;
+    const extractor_cost* smallest = nullptr;
+    double best_cost = std::numeric_limits<double>::infinity();
+    for (const extractor_cost& cost : model.extractors) {
+        if (!smallest || cost.bytes_per_edge < smallest->bytes_per_edge) smallest = &cost;
+        // Sin dato de memoria no se descarta ningún candidato
+        if (memory > 0 && cost.bytes_per_edge * hint.num_edges > memory) continue;
+        double predicted = predict_cost_ns(cost, hint);
+        if (predicted < best_cost) {
+            best_cost = predicted;
+            best = &cost;
+        }
+    }
+    if (!best) best = smallest;
+    return best ? best->name : CANDIDATES.front().name;
+}
+
+cost_model calibrate_cost_model(unsigned int max_log2_edges)
+{
+    cost_model model;
+    std::mt19937 gen(2024);
+    std::uniform_real_distribution<double> weight_dis(0.0, 2.0);
+
+    for (const candidate& c : CANDIDATES) {
+        std::vector<double> lgs, insert_ns, prepare_x, prepare_ns, extract_ns;
+        for (unsigned int lg = MIN_CALIBRATION_LOG2; lg <= std::max(max_log2_edges, MIN_CALIBRATION_LOG2); lg += 2) {
+            const size_t m = size_t(1) << lg;
+            std::vector<edge> edges(m);
+            for (size_t i = 0; i < m; ++i) edges[i] = edge(i % 4096, (i * 7) % 4096, weight_dis(gen));
+
+            std::vector<double> ins, prep, ext;
+            std::vector<edge> batch(64);
+            for (unsigned int rep = 0; rep < CALIBRATION_REPS; ++rep) {
+                // Los paralelos se miden con un hilo: predict_cost_ns() divide prepare por los hilos del trabajo
+                EdgeExtractor* extractor = c.parallel ? new RunMerge(1) : make_edge_extractor(c.name);
+                auto start = std::chrono::steady_clock::now();
+                for (const edge& e : edges) extractor->insert_edge(e);
+                ins.push_back(elapsed_ns(start));
+
+                start = std::chrono::steady_clock::now();
+                extractor->prepare();
+                prep.push_back(elapsed_ns(start));
+
+                start = std::chrono::steady_clock::now();
+                while (extractor->extract_batch(batch.data(), batch.size()) > 0) {}
+                ext.push_back(elapsed_ns(start));
+                delete extractor;
+            }
+            lgs.push_back(lg);
+            insert_ns.push_back(median_of(ins) / m);
+            prepare_x.push_back(m * static_cast<double>(lg));
+            prepare_ns.push_back(median_of(prep));
+            extract_ns.push_back(median_of(ext) / m);
+        }
+
+        extractor_cost cost;
+        cost.name = c.name;
+        fit_line(lgs, insert_ns, cost.insert_base, cost.insert_log);
+        cost.prepare = fit_through_origin(prepare_x, prepare_ns);
+        fit_line(lgs, extract_ns, cost.extract_base, cost.extract_log);
+        cost.bytes_per_edge = c.bytes_per_edge;
+        cost.parallel = c.parallel;
+        model.extractors.push_back(cost);
+    }
+    return model;
+}
+
+bool load_cost_model(const std::string& path, cost_model& model)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    cost_model loaded;
+    std::string line;
+    // Un encabezado distinto es un caché de otra versión del modelo (p.ej. prepare paralelo)
+    if (!std::getline(file, line) || line != COST_MODEL_HEADER) return false;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        extractor_cost cost;
+        std::string field;
+        std::vector<std::string> fields;
+        while (std::getline(ss, field, ',')) fields.push_back(field);
+        if (fields.size() != 8) return false;
+        try {
+            cost.name = fields[0];
+            cost.insert_base = std::stod(fields[1]);
+            cost.insert_log = std::stod(fields[2]);
+            cost.prepare = std::stod(fields[3]);
+            cost.extract_base = std::stod(fields[4]);
+            cost.extract_log = std::stod(fields[5]);
+            cost.bytes_per_edge = std::stod(fields[6]);
+            cost.parallel = fields[7] == "1";
+        } catch (const std::exception&) {
+            return false;
+        }
+        loaded.extractors.push_back(cost);
+    }
+
+    // Un caché sin alguno de los candidatos actuales se vuelve a calibrar
+    for (const candidate& c : CANDIDATES) {
+        auto found = std::find_if(loaded.extractors.begin(), loaded.extractors.end(),
+                                  [&](const extractor_cost& cost) { return cost.name == c.name; });
+        if (found == loaded.extractors.end()) return false;
+    }
+    model = loaded;
+    return true;
+}
+
+bool save_cost_model(const std::string& path, const cost_model& model)
+{
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) std::filesystem::create_directories(parent);
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << COST_MODEL_HEADER << "\n";
+    file.precision(10);
+    for (const extractor_cost& cost : model.extractors) {
+        file << cost.name << "," << cost.insert_base << "," << cost.insert_log << "," << cost.prepare << ","
+             << cost.extract_base << "," << cost.extract_log << "," << cost.bytes_per_edge << "," << cost.parallel << "\n";
+    }
+    return file.good();
+}
+
+const cost_model& shared_cost_model(const std::string& path)
+{
+    static std::once_flag once;
+    static cost_model model;
+    std::call_once(once, [&]() {
+        if (!load_cost_model(path, model)) {
+            model = calibrate_cost_model();
+            save_cost_model(path, model);
+        }
+    });
+    return model;
+}
+
+EdgeExtractor* make_edge_extractor(const std::string& name, const extraction_hint& hint, const std::string& model_path)
+{
+    if (name == AUTO_EXTRACTOR_NAME) return new AutoExtractor(shared_cost_model(model_path), hint);
+    if (name == "RunMerge") return new RunMerge(hint.threads);
+    return make_edge_extractor(name);
+}
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include "../include/batch_mst.h"
+#include "../include/simd_sort.h"
+#include "../include/edge_generation.h"
+#include "union_find.hpp"
+
+namespace {
+
+/**
+ * @brief Aristas desde las que conviene ordenar pares (peso, índice), igual que en ArraySort
+ */
+constexpr size_t KEY_INDEX_MIN_EDGES = 256;
+
+/**
+ * @brief Aristas desde las que se ordena por rondas en vez de ordenar todo de una vez
+ */
+constexpr size_t FILTER_MIN_EDGES = 1024;
+
+/**
+ * @brief Pesos que se muestrean para estimar el umbral de cada ronda
+ */
+constexpr size_t PIVOT_SAMPLE = 1024;
+
+/**
+ * @brief Instancias que toma un hilo de una vez del contador compartido
+ */
+constexpr size_t INSTANCES_PER_GRAB = 16;
+
+/**
+ * @brief Buffers de un hilo, reutilizados por todas las instancias que resuelve
+ */
+struct batch_scratch
+{
+    std::vector<double> keys;
+    std::vector<uint32_t> index;
+    sort_scratch sort_buffers;
+    std::vector<edge> sorted;
+    std::vector<double> sample;
+    UnionFind uf;
+
+    explicit batch_scratch(bool opti_path) : uf(0, opti_path) {}
+};
+
+void solve_instance(const MSTBatch& batch, size_t i, sort_kernel kernel, batch_scratch& scratch, mst_batch_result& result)
+{
+    const edge* in = batch.instance_edges(i);
+    const size_t m = batch.instance_edge_count(i);
+    const int n = batch.num_nodes(i);
+    edge* out = result.mst_edges.data() + result.first_mst_edge[i];
+
+    UnionFind& uf = scratch.uf;
+    uf.reset(n);
+    int accepted = 0;
+    double total = 0.0;
+    auto consider = [&](const edge& e) {
+        const int root_u = uf.find(e.u);
+        const int root_v = uf.find(e.v);
+        if (root_u == root_v) return;
+        uf.link(root_u, root_v);
+        out[accepted++] = e;
+        total += e.weight;
+    };
+
+    if (kernel != sort_kernel::avx2 || m < KEY_INDEX_MIN_EDGES) {
+        scratch.sorted.assign(in, in + m);
+        std::sort(scratch.sorted.begin(), scratch.sorted.end(),
+                  [](const edge& a, const edge& b) { return a.weight < b.weight; });
+        for (size_t k = 0; k < m && accepted < n - 1; ++k) consider(scratch.sorted[k]);
+    } else {
+        // Kruskal por rondas (como Filter-Kruskal): cada ronda ordena solo las
+        // aristas con peso en (lower, upper] cuyos extremos siguen en componentes
+        // distintas. El primer umbral es el cuantil ~2·n·ln(n)/m de una muestra,
+        // lo que sobra para un grafo geométrico completo; si no alcanza, la
+        // fracción se cuadruplica en la ronda siguiente
+        const size_t step = std::max<size_t>(1, m / PIVOT_SAMPLE);
+        scratch.sample.clear();
+        for (size_t k = 0; k < m; k += step) scratch.sample.push_back(in[k].weight);
+        double fraction = 2.0 * n * std::log(std::max(n, 2)) / m;
+        if (m < FILTER_MIN_EDGES || fraction > 0.5) fraction = 1.0;  // Filtrar no compensa: una sola ronda con todo
+        double lower = -std::numeric_limits<double>::infinity();
+        for (int round = 0; accepted < n - 1 && lower < std::numeric_limits<double>::infinity(); ++round) {
+            double upper = std::numeric_limits<double>::infinity();
+            if (fraction < 1.0) {
+                const size_t rank = static_cast<size_t>(fraction * (scratch.sample.size() - 1));
+                std::nth_element(scratch.sample.begin(), scratch.sample.begin() + rank, scratch.sample.end());
+                upper = std::max(scratch.sample[rank], lower);
+            }
+            scratch.keys.clear();
+            scratch.index.clear();
+            for (size_t k = 0; k < m; ++k) {
+                const double w = in[k].weight;
+                if (w <= lower || w > upper) continue;
+                if (round > 0 && uf.find(in[k].u) == uf.find(in[k].v)) continue;
+                scratch.keys.push_back(w);
+                scratch.index.push_back(static_cast<uint32_t>(k));
+            }
+            sort_key_index(scratch.keys, scratch.index, kernel, scratch.sort_buffers);
+            for (size_t k = 0; k < scratch.index.size() && accepted < n - 1; ++k) consider(in[scratch.index[k]]);
+            lower = upper;
+            fraction = std::min(1.0, fraction * 4);
+        }
+    }
+
+    result.weight[i] = total;
+    result.mst_size[i] = accepted;
+}
+
+} // namespace
+
+void MSTBatch::add_instance(int num_nodes, const edge* begin, size_t count)
+{
+    edges.insert(edges.end(), begin, begin + count);
+    first_edge.push_back(edges.size());
+    nodes.push_back(num_nodes);
+}
+
+void MSTBatch::grow_for(size_t extra)
+{
+    // generate_complete_edges() reserva el tamaño exacto; crecer de forma
+    // geométrica evita recopiar el arreglo plano en cada instancia
+    const size_t needed = edges.size() + extra;
+    if (needed > edges.capacity()) edges.reserve(std::max(needed, 2 * edges.capacity()));
+}
+
+void MSTBatch::reserve(size_t instances, size_t total_edges)
+{
+    edges.reserve(total_edges);
+    first_edge.reserve(instances + 1);
+    nodes.reserve(instances);
+}
+
+void MSTBatch::clear()
+{
+    edges.clear();
+    first_edge.assign(1, 0);
+    nodes.clear();
+}
+
+mst_batch_result solve_mst_batch(const MSTBatch& batch, bool opti_path, unsigned int threads)
+{
+    const size_t count = batch.size();
+    mst_batch_result result;
+    result.weight.resize(count);
+    result.mst_size.resize(count);
+    result.first_mst_edge.resize(count);
+
+    // Cada instancia tiene a lo más n-1 aristas en su MST: rangos fijos de antemano
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        result.first_mst_edge[i] = offset;
+        offset += std::max(batch.num_nodes(i) - 1, 0);
+    }
+    result.mst_edges.resize(offset);
+
+    const sort_kernel kernel = active_sort_kernel();
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        batch_scratch scratch(opti_path);
+        while (true) {
+            const size_t begin = next.fetch_add(INSTANCES_PER_GRAB, std::memory_order_relaxed);
+            if (begin >= count) return;
+            const size_t end = std::min(begin + INSTANCES_PER_GRAB, count);
+            for (size_t i = begin; i < end; ++i) solve_instance(batch, i, kernel, scratch, result);
+        }
+    };
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned int>(std::min<size_t>(threads, (count + INSTANCES_PER_GRAB - 1) / INSTANCES_PER_GRAB));
+    if (threads <= 1) {
+        work();
+    } else {
+        std::vector<std::jthread> pool;
+        for (unsigned int t = 0; t < threads; ++t) pool.emplace_back(work);
+    }
+
+    // Compactar las aristas cuando alguna instancia resultó ser un bosque
+    size_t write = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t read = result.first_mst_edge[i];
+        if (read != write) {
+            std::copy(result.mst_edges.begin() + read, result.mst_edges.begin() + read + result.mst_size[i],
+                      result.mst_edges.begin() + write);
+        }
+        result.first_mst_edge[i] = write;
+        write += result.mst_size[i];
+    }
+    result.mst_edges.resize(write);
+    return result;
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "../include/benchmark.h"
+#include "../include/stats.h"
+
+// CPUs del conjunto permitido al proceso, en orden
+static std::vector<int> allowed_cpus()
+{
+    std::vector<int> cpus;
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+unsigned int available_cpus()
+{
+    return std::max<unsigned int>(1, allowed_cpus().size());
+}
+
+bool pin_current_thread(unsigned int worker_id, unsigned int cpus_per_worker)
+{
+    const std::vector<int> cpus = allowed_cpus();
+    if (cpus.empty()) return false;
+
+    cpu_set_t target;
+    CPU_ZERO(&target);
+    const size_t first = size_t(worker_id) * std::max(1u, cpus_per_worker);
+    for (size_t i = 0; i < std::max(1u, cpus_per_worker); ++i) {
+        CPU_SET(cpus[(first + i) % cpus.size()], &target);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(target), &target) == 0;
+}
+
+void BenchRecorder::add(const bench_sample& sample)
+{
+    std::lock_guard lock(m_samples);
+    samples.push_back(sample);
+}
+
+bool BenchRecorder::write(const std::string& runs_path, const std::string& summary_path, bool with_clusters)
+{
+    std::lock_guard lock(m_samples);
+
+    // Agrupar las corridas medidas por configuración
+    using key_t = std::tuple<unsigned long long, std::string, bool, unsigned int>;
+    std::map<key_t, std::vector<double>> insertion, kruskal;
+    for (const bench_sample& s : samples) {
+        if (s.warmup) continue;
+        key_t key{s.data.n, s.data.edge_extractor_name, s.data.opti_path, s.data.clusters};
+        insertion[key].push_back(s.data.time_insertion);
+        kruskal[key].push_back(s.data.time_kruskal);
+    }
+
+    std::map<key_t, sample_summary> summary_insertion, summary_kruskal;
+    for (const auto& [key, values] : insertion) summary_insertion[key] = summarize(values);
+    for (const auto& [key, values] : kruskal) summary_kruskal[key] = summarize(values);
+
+    std::ofstream runs(runs_path, std::ios::out);
+    std::ofstream summary(summary_path, std::ios::out);
+    if (!runs.is_open() || !summary.is_open()) return false;
+
+    runs << std::setprecision(10);
+    // La columna Clusters solo aparece si se pidió k-clustering, para no cambiar el formato original
+    const std::string clusters_header = with_clusters ? ",Clusters" : "";
+    runs << "N,EdgeExtractorName,KruskalOptiPath" << clusters_header
+         << ",Rep,Run,Warmup,TimeInsertion,TimeKruskal,OutlierInsertion,OutlierKruskal\n";
+    for (const bench_sample& s : samples) {
+        key_t key{s.data.n, s.data.edge_extractor_name, s.data.opti_path, s.data.clusters};
+        bool outlier_insertion = false, outlier_kruskal = false;
+        if (!s.warmup) {
+            const sample_summary& si = summary_insertion[key];
+            const sample_summary& sk = summary_kruskal[key];
+            outlier_insertion = is_outlier(s.data.time_insertion, si.median, si.mad);
+            outlier_kruskal = is_outlier(s.data.time_kruskal, sk.median, sk.mad);
+        }
+        runs << s.data.n << "," << s.data.edge_extractor_name << "," << s.data.opti_path << ",";
+        if (with_clusters) runs << s.data.clusters << ",";
+        runs << s.rep << "," << s.run << "," << s.warmup << ","
+             << s.data.time_insertion << "," << s.data.time_kruskal << ","
+             << outlier_insertion << "," << outlier_kruskal << "\n";
+    }
+
+    summary << std::setprecision(10);
+    summary << "N,EdgeExtractorName,KruskalOptiPath" << clusters_header
+            << ",Metric,Runs,Median,MAD,CI95Low,CI95High,Outliers\n";
+    for (const auto& [metric, summaries] : {std::pair{"TimeInsertion", &summary_insertion},
+                                            std::pair{"TimeKruskal", &summary_kruskal}}) {
+        for (const auto& [key, s] : *summaries) {
+            summary << std::get<0>(key) << "," << std::get<1>(key) << "," << std::get<2>(key) << ",";
+            if (with_clusters) summary << std::get<3>(key) << ",";
+            summary << metric << "," << s.count << "," << s.median << "," << s.mad << ","
+                    << s.ci95_low << "," << s.ci95_high << "," << s.outliers << "\n";
+        }
+    }
+    return runs.good() && summary.good();
+}
@@ -0,0 +1,288 @@
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
+#include "../include/boruvka_emst.h"
+#include "union_find.hpp"
+
+namespace {
+
+/**
+ * @brief Máximo de puntos de una hoja del kd-tree
+ */
+constexpr int LEAF_SIZE = 16;
+
+constexpr double NO_CANDIDATE = std::numeric_limits<double>::infinity();
+
+/**
+ * @brief kd-tree con los puntos reordenados: cada nodo es un rango contiguo de posiciones
+ * Los hijos se guardan después de su padre, así que recorrer los nodos al revés
+ * procesa siempre los hijos antes que el padre.
+ */
+template <size_t D>
+struct kd_tree
+{
+    struct kd_node
+    {
+        std::array<double, D> lo, hi; ///< Caja de los puntos del nodo
+        int begin, end;               ///< Posiciones [begin, end)
+        int left = -1, right = -1;    ///< Hijos (-1 en una hoja)
+
+        bool leaf() const { return left < 0; }
+    };
+
+    std::vector<kd_node> nodes;
+    PointSet<D> points;   ///< Puntos en el orden del árbol
+    std::vector<int> ids; ///< Índice original del punto en cada posición
+    int max_leaf = 0;     ///< Puntos de la hoja más grande (puede superar LEAF_SIZE con puntos repetidos)
+
+    int build(const PointSet<D>& input, int begin, int end)
+    {
+        const int id = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+        kd_node node;
+        node.begin = begin;
+        node.end = end;
+        for (size_t d = 0; d < D; ++d) node.lo[d] = node.hi[d] = input(ids[begin], d);
+        for (int i = begin + 1; i < end; ++i) {
+            for (size_t d = 0; d < D; ++d) {
+                node.lo[d] = std::min(node.lo[d], input(ids[i], d));
+                node.hi[d] = std::max(node.hi[d], input(ids[i], d));
+            }
+        }
+
+        // División por la mediana de la coordenada más extendida
+        size_t split = 0;
+        for (size_t d = 1; d < D; ++d) {
+            if (node.hi[d] - node.lo[d] > node.hi[split] - node.lo[split]) split = d;
+        }
+        if (end - begin > LEAF_SIZE && node.hi[split] > node.lo[split]) {
+            const int mid = begin + (end - begin) / 2;
+            std::nth_element(ids.begin() + begin, ids.begin() + mid, ids.begin() + end,
+                             [&](int a, int b) { return input(a, split) < input(b, split); });
+            node.left = build(input, begin, mid);
+            node.right = build(input, mid, end);
+        } else {
+            max_leaf = std::max(max_leaf, end - begin);
+        }
+        nodes[id] = node;
+        return id;
+    }
+
+    explicit kd_tree(const PointSet<D>& input) : ids(input.size())
+    {
+        std::iota(ids.begin(), ids.end(), 0);
+        nodes.reserve(2 * (input.size() / LEAF_SIZE + 1));
+        build(input, 0, static_cast<int>(input.size()));
+        points.resize(input.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            for (size_t d = 0; d < D; ++d) points(i, d) = input(ids[i], d);
+        }
+    }
+};
+
+/**
+ * @brief Estado de una búsqueda dual-tree de las aristas mínimas de cada componente
+ * Las componentes se identifican por su raíz en el Union-Find (una posición del árbol).
+ */
+template <size_t D, typename Metric>
+class boruvka_search
+{
+    const kd_tree<D>& tree;
+    emst_result& result;
+    std::vector<int> point_comp;     ///< Componente de cada posición
+    std::vector<int> node_comp;      ///< Componente común de los puntos del nodo, o -1
+    std::vector<double> node_bound;  ///< Cota superior de la mejor candidata de las componentes del nodo
+    std::vector<double> best_weight; ///< Mejor candidata de cada componente
+    std::vector<int> best_from, best_to;
+    std::vector<double> row;         ///< Pesos de un punto contra una hoja
+
+    double box_distance(int a, int b) const
+    {
+        const auto& na = tree.nodes[a];
+        const auto& nb = tree.nodes[b];
+        double acc = 0.0;
+        for (size_t d = 0; d < D; ++d) {
+            const double gap = std::max({0.0, na.lo[d] - nb.hi[d], nb.lo[d] - na.hi[d]});
+            acc = Metric::accumulate(acc, gap);
+        }
+        return acc;
+    }
+
+    double point_box_distance(int i, const typename kd_tree<D>::kd_node& node) const
+    {
+        double acc = 0.0;
+        for (size_t d = 0; d < D; ++d) {
+            const double x = tree.points(i, d);
+            acc = Metric::accumulate(acc, std::max({0.0, node.lo[d] - x, x - node.hi[d]}));
+        }
+        return acc;
+    }
+
+    // Orden total (peso, menor índice original, mayor índice original): sin empates,
+    // la arista mínima de cada componente es única y Borůvka no forma ciclos
+    bool better(double weight, int from, int to, int comp) const
+    {
+        if (weight != best_weight[comp]) return weight < best_weight[comp];
+        if (best_from[comp] < 0) return true;
+        const auto key = std::minmax(tree.ids[from], tree.ids[to]);
+        const auto best = std::minmax(tree.ids[best_from[comp]], tree.ids[best_to[comp]]);
+        return key < best;
+    }
+
+    void base_case(int q, int r)
+    {
+        const auto& nq = tree.nodes[q];
+        const auto& nr = tree.nodes[r];
+        const int count = nr.end - nr.begin;
+        for (int i = nq.begin; i < nq.end; ++i) {
+            const int comp = point_comp[i];
+            if (comp == node_comp[r] || point_box_distance(i, nr) > best_weight[comp]) continue;
+            std::fill(row.begin(), row.begin() + count, 0.0);
+            for (size_t d = 0; d < D; ++d) {
+                const double* axis = tree.points.axis(d) + nr.begin;
+                const double coordinate = tree.points(i, d);
+                for (int k = 0; k < count; ++k) row[k] = Metric::accumulate(row[k], coordinate - axis[k]);
+            }
+            result.distance_evaluations += count;
+            for (int k = 0; k < count; ++k) {
+                const int j = nr.begin + k;
+                if (point_comp[j] != comp && row[k] <= best_weight[comp] && better(row[k], i, j, comp)) {
+                    best_weight[comp] = row[k];
+                    best_from[comp] = i;
+                    best_to[comp] = j;
+                }
+            }
+        }
+        double bound = 0.0;
+        for (int i = nq.begin; i < nq.end; ++i) bound = std::max(bound, best_weight[point_comp[i]]);
+        node_bound[q] = bound;
+    }
+
+    void search_closer_first(int q, int a, int b)
+    {
+        if (box_distance(q, b) < box_distance(q, a)) std::swap(a, b);
+        search(q, a);
+        search(q, b);
+    }
+
+public:
+    boruvka_search(const kd_tree<D>& tree, emst_result& result)
+        : tree(tree), result(result), point_comp(tree.ids.size()), node_comp(tree.nodes.size()),
+          node_bound(tree.nodes.size()), best_weight(tree.ids.size()), best_from(tree.ids.size()),
+          best_to(tree.ids.size()), row(tree.max_leaf) {}
+
+    /**
+     * @brief Prepara una ronda: componentes de puntos y nodos, candidatas vacías
+     */
+    void refresh(UnionFind& uf)
+    {
+        for (size_t i = 0; i < point_comp.size(); ++i) point_comp[i] = uf.find(static_cast<int>(i));
+        std::fill(best_weight.begin(), best_weight.end(), NO_CANDIDATE);
+        std::fill(best_from.begin(), best_from.end(), -1);
+        std::fill(node_bound.begin(), node_bound.end(), NO_CANDIDATE);
+        for (size_t id = tree.nodes.size(); id-- > 0;) {
+            const auto& node = tree.nodes[id];
+            if (node.leaf()) {
+                int comp = point_comp[node.begin];
+                for (int i = node.begin + 1; i < node.end && comp >= 0; ++i) {
+                    if (point_comp[i] != comp) comp = -1;
+                }
+                node_comp[id] = comp;
+            } else {
+                node_comp[id] = node_comp[node.left] == node_comp[node.right] ? node_comp[node.left] : -1;
+            }
+        }
+    }
+
+    /**
+     * @brief Busca, para las componentes de los puntos de q, la arista mínima hacia puntos de r
+     */
+    void search(int q, int r)
+    {
+        result.node_pairs++;
+        const auto& nq = tree.nodes[q];
+        const auto& nr = tree.nodes[r];
+        if ((node_comp[q] >= 0 && node_comp[q] == node_comp[r]) || box_distance(q, r) > node_bound[q]) {
+            result.pruned_pairs++;
+            return;
+        }
+        if (nq.leaf() && nr.leaf()) {
+            base_case(q, r);
+            return;
+        }
+        if (nq.leaf()) {
+            search_closer_first(q, nr.left, nr.right);
+            return;
+        }
+        if (nr.leaf()) {
+            search(nq.left, r);
+            search(nq.right, r);
+        } else {
+            search_closer_first(nq.left, nr.left, nr.right);
+            search_closer_first(nq.right, nr.left, nr.right);
+        }
+        node_bound[q] = std::max(node_bound[nq.left], node_bound[nq.right]);
+    }
+
+    /**
+     * @brief Une cada componente con su arista mínima y agrega esas aristas al resultado
+     */
+    void merge(UnionFind& uf)
+    {
+        for (size_t comp = 0; comp < point_comp.size(); ++comp) {
+            if (point_comp[comp] != static_cast<int>(comp) || best_from[comp] < 0) continue;
+            const int root_u = uf.find(best_from[comp]);
+            const int root_v = uf.find(best_to[comp]);
+            if (root_u == root_v) continue; // La otra componente ya eligió la misma arista
+            uf.link(root_u, root_v);
+            const auto [u, v] = std::minmax(tree.ids[best_from[comp]], tree.ids[best_to[comp]]);
+            result.edges.emplace_back(u, v, best_weight[comp]);
+            result.weight += best_weight[comp];
+        }
+    }
+};
+
+} // namespace
+
+template <size_t D, coordinate_metric Metric>
+emst_result dual_tree_boruvka(const PointSet<D>& points)
+{
+    emst_result result;
+    const size_t n = points.size();
+    if (n < 2) return result;
+    const kd_tree<D> tree(points);
+    UnionFind uf(static_cast<int>(n), true);
+    boruvka_search<D, Metric> search(tree, result);
+    result.edges.reserve(n - 1);
+    while (result.edges.size() + 1 < n) {
+        search.refresh(uf);
+        search.search(0, 0);
+        search.merge(uf);
+        result.rounds++;
+    }
+    return result;
+}
+
+#define INSTANTIATE_DUAL_TREE_BORUVKA(D)                                                     \
+    template emst_result dual_tree_boruvka<D, squared_l2>(const PointSet<D>&);              \
+    template emst_result dual_tree_boruvka<D, l1_distance>(const PointSet<D>&);             \
+    template emst_result dual_tree_boruvka<D, linf_distance>(const PointSet<D>&);
+
+INSTANTIATE_DUAL_TREE_BORUVKA(2)
+INSTANTIATE_DUAL_TREE_BORUVKA(3)
+INSTANTIATE_DUAL_TREE_BORUVKA(4)
+INSTANTIATE_DUAL_TREE_BORUVKA(5)
+INSTANTIATE_DUAL_TREE_BORUVKA(6)
+INSTANTIATE_DUAL_TREE_BORUVKA(7)
+INSTANTIATE_DUAL_TREE_BORUVKA(8)
+INSTANTIATE_DUAL_TREE_BORUVKA(9)
+INSTANTIATE_DUAL_TREE_BORUVKA(10)
+INSTANTIATE_DUAL_TREE_BORUVKA(11)
+INSTANTIATE_DUAL_TREE_BORUVKA(12)
+INSTANTIATE_DUAL_TREE_BORUVKA(13)
+INSTANTIATE_DUAL_TREE_BORUVKA(14)
+INSTANTIATE_DUAL_TREE_BORUVKA(15)
+INSTANTIATE_DUAL_TREE_BORUVKA(16)
+static_assert(EMST_MAX_DIMENSION == 16, "actualizar las instancias de dual_tree_boruvka()");
@@ -0,0 +1,143 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "../include/checkpoint.h"
+
+namespace {
+
+std::vector<std::string> split_row(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) fields.push_back(field);
+    return fields;
+}
+
+// "Auto(HeapMin)" se guarda como "Auto": así se compara con el nombre de la configuración
+std::string base_name(const std::string& name)
+{
+    return name.substr(0, name.find('('));
+}
+
+std::string cache_path(const std::string& dir, unsigned int log2_n, unsigned int seed)
+{
+    return (std::filesystem::path(dir) / ("points_n" + std::to_string(log2_n) + "_s" + std::to_string(seed) + ".bin")).string();
+}
+
+} // namespace
+
+bool SweepCheckpoint::load(const std::string& path, const std::string& header, const std::string& fingerprint,
+                           std::string& error)
+{
+    completed.clear();
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) return true;
+
+    std::string content;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            error = "no se pudo leer " + path;
+            return false;
+        }
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        content = buffer.str();
+    }
+
+    // Descartar una última fila incompleta
+    const size_t complete = content.empty() || content.back() == '\n' ? content.size() : content.rfind('\n') + 1;
+    if (complete != content.size()) {
+        std::filesystem::resize_file(path, complete, ec);
+        if (ec) {
+            error = "no se pudo truncar la fila incompleta de " + path;
+            return false;
+        }
+        content.resize(complete);
+    }
+    if (content.empty()) return true;
+
+    std::istringstream lines(content);
+    std::string line;
+    std::getline(lines, line);
+    if (line != header) {
+        error = path + " tiene otras columnas que la configuración actual (usar otro --df o borrarlo)";
+        return false;
+    }
+    const std::vector<std::string> columns = split_row(header);
+    auto column = [&](const std::string& name) -> int {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (columns[i] == name) return static_cast<int>(i);
+        }
+        return -1;
+    };
+    const int col_n = column("N");
+    const int col_extractor = column("EdgeExtractorName");
+    const int col_opti = column("KruskalOptiPath");
+    const int col_seed = column(SEED_COLUMN);
+    const int col_clusters = column("Clusters");
+    const int col_config = column(CONFIG_COLUMN);
+    if (col_seed < 0 || col_config < 0) {
+        error = path + " no tiene las columnas " + SEED_COLUMN + " y " + CONFIG_COLUMN;
+        return false;
+    }
+
+    while (std::getline(lines, line)) {
+        const std::vector<std::string> fields = split_row(line);
+        if (fields.size() != columns.size()) continue;
+        // Filas medidas con otra métrica, aristas, asignador, etc. no son comparables
+        if (fields[col_config] != fingerprint) {
+            error = path + " se generó con " + fields[col_config] + " y la configuración actual es " + fingerprint
+                  + " (usar otro --df)";
+            completed.clear();
+            return false;
+        }
+        try {
+            completed.emplace(std::stoull(fields[col_n]), static_cast<unsigned int>(std::stoul(fields[col_seed])),
+                              base_name(fields[col_extractor]), fields[col_opti] == "1",
+                              col_clusters < 0 ? 0u : static_cast<unsigned int>(std::stoul(fields[col_clusters])));
+        } catch (const std::exception&) {
+            // Una fila ilegible no cuenta como completada: el experimento se repite
+        }
+    }
+    return true;
+}
+
+bool SweepCheckpoint::done(unsigned long long n, unsigned int seed, const std::string& extractor, bool opti_path, unsigned int clusters) const
+{
+    return completed.count({n, seed, extractor, opti_path, clusters}) > 0;
+}
+
+bool load_cached_points(const std::string& dir, unsigned int log2_n, unsigned int seed, std::vector<node>& nodes)
+{
+    std::ifstream in(cache_path(dir, log2_n, seed), std::ios::binary);
+    if (!in) return false;
+    uint64_t count = 0;
+    if (!in.read(reinterpret_cast<char*>(&count), sizeof(count)) || count != (uint64_t(1) << log2_n)) return false;
+    nodes.resize(count);
+    if (!in.read(reinterpret_cast<char*>(nodes.data()), count * sizeof(node))) {
+        nodes.clear();
+        return false;
+    }
+    return true;
+}
+
+bool store_cached_points(const std::string& dir, unsigned int log2_n, unsigned int seed, const std::vector<node>& nodes)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    const std::string path = cache_path(dir, log2_n, seed);
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        const uint64_t count = nodes.size();
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char*>(nodes.data()), count * sizeof(node));
+        if (!out) return false;
+    }
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/config.h"
+#include "../include/edge_extractor.h"
+#include "../include/auto_extractor.h"
+
+namespace {
+
+/**
+ * @brief Nombre con el que parse lee un valor (el inverso de parse sobre names)
+ */
+template <typename T, typename Parse>
+std::string option_name(T value, std::initializer_list<const char*> names, Parse parse)
+{
+    for (const char* name : names) {
+        T parsed{};
+        if (parse(name, parsed) && parsed == value) return name;
+    }
+    return "?";
+}
+
+/**
+ * @brief Separa una lista "a,b,c" en sus elementos no vacíos
+ */
+std::vector<std::string> split_list(const std::string& value)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+bool parse_uint(const std::string& key, const std::string& value, unsigned int& out)
+{
+    try {
+        size_t pos = 0;
+        unsigned long parsed = std::stoul(value, &pos);
+        if (pos != value.size()) throw std::invalid_argument(value);
+        out = static_cast<unsigned int>(parsed);
+        return true;
+    } catch (const std::exception&) {
+        std::cerr << "Error: valor inválido para " << key << ": '" << value << "'" << std::endl;
+        return false;
+    }
+}
+
+bool parse_double(const std::string& key, const std::string& value, double& out)
+{
+    try {
+        size_t pos = 0;
+        out = std::stod(value, &pos);
+        if (pos != value.size()) throw std::invalid_argument(value);
+        return true;
+    } catch (const std::exception&) {
+        std::cerr << "Error: valor inválido para " << key << ": '" << value << "'" << std::endl;
+        return false;
+    }
+}
+
+bool parse_bool(const std::string& key, const std::string& value, bool& out)
+{
+    if (value == "1" || value == "true") { out = true; return true; }
+    if (value == "0" || value == "false") { out = false; return true; }
+    std::cerr << "Error: " << key << " espera 0 o 1, recibido '" << value << "'" << std::endl;
+    return false;
+}
+
+/**
+ * @brief Aplica una opción "clave = valor" sobre la configuración
+ * Es compartida por la línea de comandos y los archivos de configuración.
+ */
+bool apply_option(const std::string& key, const std::string& value, experiment_config& config)
+{
+    if (key == "log2-n-init") return parse_uint(key, value, config.log2_n_init);
+    if (key == "log2-n-end") return parse_uint(key, value, config.log2_n_end);
+    if (key == "n-range") {
+        size_t sep = value.find(':');
+        if (sep == std::string::npos) {
+            std::cerr << "Error: n-range espera el formato INICIO:FIN (log2 N)" << std::endl;
+            return false;
+        }
+        return parse_uint(key, value.substr(0, sep), config.log2_n_init)
+            && parse_uint(key, value.substr(sep + 1), config.log2_n_end);
+    }
+    if (key == "reps") return parse_uint(key, value, config.repetitions);
+    if (key == "seed") return parse_uint(key, value, config.seed);
+    if (key == "threads") return parse_uint(key, value, config.max_threads);
+    if (key == "df") { config.df_path = value; return true; }
+    if (key == "logs") { config.logs_path = value; return true; }
+    if (key == "extractors") {
+        config.extractors = split_list(value);
+        for (const std::string& name : config.extractors) {
+            if (name == AUTO_EXTRACTOR_NAME) continue;
+            EdgeExtractor* probe = make_edge_extractor(name);
+            if (!probe) {
+                std::cerr << "Error: extractor desconocido '" << name << "'" << std::endl;
+                return false;
+            }
+            delete probe;
+        }
+        return true;
+    }
+    if (key == "opti-path") {
+        config.opti_paths.clear();
+        for (const std::string& item : split_list(value)) {
+            if (item != "0" && item != "1") {
+                std::cerr << "Error: opti-path solo acepta 0 y 1, recibido '" << item << "'" << std::endl;
+                return false;
+            }
+            config.opti_paths.push_back(item == "1");
+        }
+        return true;
+    }
+    if (key == "perf") return parse_bool(key, value, config.perf_counters);
+    if (key == "memory") return parse_bool(key, value, config.memory_tracking);
+    if (key == "trace") { config.trace_path = value; return true; }
+    if (key == "cost-model") { config.cost_model_path = value; return true; }
+    if (key == "alloc") {
+        if (!parse_arena_mode(value, config.allocator)) {
+            std::cerr << "Error: alloc solo acepta system, arena o huge, recibido '" << value << "'" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    if (key == "prefault") return parse_bool(key, value, config.prefault);
+    if (key == "sort-kernel") {
+        if (!parse_sort_kernel(value, config.array_sort)) {
+            std::cerr << "Error: sort-kernel solo acepta auto, std, scalar o avx2, recibido '" << value << "'" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    if (key == "resume") return parse_bool(key, value, config.resume);
+    if (key == "input-cache") { config.input_cache = value; return true; }
+    if (key == "serve") { config.serve = value; return true; }
+    if (key == "batch") return parse_uint(key, value, config.kruskal_batch);
+    if (key == "krt") return parse_bool(key, value, config.reconstruction_tree);
+    if (key == "clusters") {
+        config.clusters.clear();
+        for (const std::string& item : split_list(value)) {
+            unsigned int k = 0;
+            if (!parse_uint(key, item, k)) return false;
+            config.clusters.push_back(k);
+        }
+        return true;
+    }
+    if (key == "edges") {
+        if (!parse_edge_mode(value, config.edges)) {
+            std::cerr << "Error: edges solo acepta complete o radius, recibido '" << value << "'" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    if (key == "radius-c") return parse_double(key, value, config.radius_c);
+    if (key == "metric") {
+        if (!parse_metric(value, config.metric)) {
+            std::cerr << "Error: metric solo acepta sqeuclidean, l1 o linf, recibido '" << value << "'" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    if (key == "vertex-order") {
+        if (!parse_vertex_order(value, config.order)) {
+            std::cerr << "Error: vertex-order solo acepta generation, morton o hilbert, recibido '" << value << "'" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    if (key == "bench") return parse_bool(key, value, config.bench_mode);
+    if (key == "warmup") return parse_uint(key, value, config.warmup_runs);
+    if (key == "measure") return parse_uint(key, value, config.measure_runs);
+    if (key == "pin") {
+        bool pin;
+        if (!parse_bool(key, value, pin)) return false;
+        config.pin_threads = pin;
+        return true;
+    }
+    if (key == "bench-runs") { config.bench_runs_path = value; return true; }
+    if (key == "bench-summary") { config.bench_summary_path = value; return true; }
+    if (key == "config") return load_config_file(value, config);
+
+    std::cerr << "Error: opción desconocida '" << key << "'" << std::endl;
+    return false;
+}
+
+/**
+ * @brief Verifica que la configuración final describa un barrido ejecutable
+ */
+bool validate_config(const experiment_config& config)
+{
+    if (config.log2_n_init < 1 || config.log2_n_init > config.log2_n_end || config.log2_n_end > 30) {
+        std::cerr << "Error: rango de tamaños inválido 2^" << config.log2_n_init << "..2^" << config.log2_n_end << std::endl;
+        return false;
+    }
+    if (config.repetitions == 0 || config.max_threads == 0) {
+        std::cerr << "Error: reps y threads deben ser mayores que 0" << std::endl;
+        return false;
+    }
+    if (config.radius_c <= 0) {
+        std::cerr << "Error: radius-c debe ser mayor que 0" << std::endl;
+        return false;
+    }
+    if (config.kruskal_batch == 0) {
+        std::cerr << "Error: batch debe ser mayor que 0" << std::endl;
+        return false;
+    }
+    for (unsigned int k : config.clusters) {
+        if (k == 0) {
+            std::cerr << "Error: clusters solo acepta valores mayores que 0" << std::endl;
+            return false;
+        }
+    }
+    if (!config.serve.empty() && config.serve != "stdin" && config.serve.rfind("unix:", 0) != 0) {
+        std::cerr << "Error: serve solo acepta stdin o unix:RUTA, recibido '" << config.serve << "'" << std::endl;
+        return false;
+    }
+    if (config.resume && config.bench_mode) {
+        std::cerr << "Error: resume solo aplica al barrido normal (el modo benchmark escribe sus CSV al final)" << std::endl;
+        return false;
+    }
+    if (config.bench_mode && config.measure_runs == 0) {
+        std::cerr << "Error: el modo benchmark requiere measure > 0" << std::endl;
+        return false;
+    }
+    if (config.extractors.empty() || config.opti_paths.empty()) {
+        std::cerr << "Error: se requiere al menos un extractor y una política de Union-Find" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool load_config_file(const std::string& path, experiment_config& config)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: no se pudo abrir el archivo de configuración '" << path << "'" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        // Quitar espacios al inicio y al final
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t sep = line.find('=');
+        if (sep == std::string::npos) {
+            std::cerr << "Error: línea inválida en " << path << ": '" << line << "'" << std::endl;
+            return false;
+        }
+        std::string key = line.substr(0, sep);
+        std::string value = line.substr(sep + 1);
+        key.erase(key.find_last_not_of(" \t") + 1);
+        value.erase(0, value.find_first_not_of(" \t"));
+        if (!apply_option(key, value, config)) return false;
+    }
+    return true;
+}
+
+bool parse_config(int argc, char** argv, experiment_config& config)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            print_usage(argv[0]);
+            return false;
+        }
+        if (arg.rfind("--", 0) != 0) {
+            std::cerr << "Error: argumento inesperado '" << arg << "'" << std::endl;
+            return false;
+        }
+
+        // Se aceptan tanto "--clave=valor" como "--clave valor"
+        std::string key = arg.substr(2);
+        std::string value;
+        size_t sep = key.find('=');
+        if (sep != std::string::npos) {
+            value = key.substr(sep + 1);
+            key = key.substr(0, sep);
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            std::cerr << "Error: falta el valor de --" << key << std::endl;
+            return false;
+        }
+        if (!apply_option(key, value, config)) return false;
+    }
+    return validate_config(config);
+}
+
+void print_usage(const char* prog)
+{
+    std::cout << "Uso: " << prog << " [opciones]\n"
+              << "  --n-range A:B        Tamaños 2^A..2^B (equivale a --log2-n-init A --log2-n-end B)\n"
+              << "  --log2-n-init A      Primer tamaño del barrido (log2 N, por defecto 5)\n"
+              << "  --log2-n-end B       Último tamaño del barrido (log2 N, por defecto 14)\n"
+              << "  --reps R             Secuencias por tamaño (por defecto 5)\n"
+              << "  --seed S             Semilla base (por defecto 1234)\n"
+              << "  --threads T          Número máximo de hilos (por defecto 1)\n"
+              << "  --extractors L       Lista de extractores, p.ej. ArraySort,HeapMin,SequenceHeap (Auto elige según un modelo de costo)\n"
+              << "  --cost-model PATH    Caché del modelo de costo de Auto (por defecto resultados/cost_model.csv)\n"
+              << "  --opti-path L        Políticas de Union-Find: 1 (path compression), 0 (básico)\n"
+              << "  --df PATH            Archivo CSV de resultados (por defecto resultados/df.csv)\n"
+              << "  --logs PATH          Archivo de logs (por defecto resultados/logs.txt)\n"
+              << "  --perf 0|1           Agregar a df.csv contadores de hardware (perf_event_open) por fase\n"
+              << "  --memory 0|1         Agregar a df.csv memoria residente máxima y bytes asignados por fase\n"
+              << "  --trace PATH         Escribir una traza JSON (Chrome/Perfetto) de las fases de cada hilo\n"
+              << "  --alloc MODE         Memoria de los arreglos de aristas: system, arena (por hilo, reutilizada) o huge (páginas de 2 MB)\n"
+              << "  --prefault 0|1       Tocar las páginas de la arena al mapearlas (fuera del tiempo de inserción)\n"
+              << "  --vertex-order O     Numeración de vértices antes de generar aristas: generation, morton o hilbert\n"
+              << "  --edges MODE         Aristas generadas: complete (todos los pares) o radius (peso <= c·ln(n)/n, grilla espacial)\n"
+              << "  --radius-c C         Constante del umbral inicial en modo radius (por defecto 2); se duplica hasta que el grafo sea conexo\n"
+              << "  --metric M           Peso de las aristas: sqeuclidean (por defecto), l1 o linf\n"
+              << "  --sort-kernel K      Ordenamiento de ArraySort: auto, std (aristas completas), scalar o avx2 (pares peso/índice)\n"
+              << "  --batch K            Aristas por lote en Kruskal, con prefetch del Union-Find (por defecto 64; 1 = una a una)\n"
+              << "  --krt 0|1            Construir en Kruskal el árbol de reconstrucción con LCA O(1) (cuenta en TimeKruskal)\n"
+              << "  --clusters L         Lista de k para single-linkage: Kruskal se detiene en k componentes (p.ej. 1,8,64)\n"
+              << "  --resume 0|1         Continuar df.csv: agrega filas y salta las combinaciones (N, semilla, extractor, opti_path) ya hechas\n"
+              << "  --input-cache DIR    Guardar/reutilizar los puntos generados de cada (N, semilla) en DIR\n"
+              << "  --serve MODO         Servicio persistente de MST: stdin o unix:RUTA (socket Unix, --threads conexiones)\n"
+              << "  --bench 0|1          Modo benchmark: calentamiento, corridas repetidas y resumen estadístico\n"
+              << "  --warmup W           Corridas de calentamiento por entrada en modo benchmark (por defecto 2)\n"
+              << "  --measure R          Corridas medidas por entrada en modo benchmark (por defecto 10)\n"
+              << "  --pin 0|1            Fijar cada worker a su bloque de CPUs (por defecto solo en modo benchmark)\n"
+              << "  --bench-runs PATH    CSV con cada corrida (por defecto resultados/bench_runs.csv)\n"
+              << "  --bench-summary PATH CSV con mediana, MAD e IC 95% (por defecto resultados/bench_summary.csv)\n"
+              << "  --config PATH        Archivo con líneas 'clave = valor' usando las mismas claves\n";
+}
+
+unsigned int job_seed(const experiment_config& config, unsigned int log2_n, unsigned int rep)
+{
+    std::seed_seq seq{config.seed, log2_n, rep};
+    unsigned int seed;
+    seq.generate(&seed, &seed + 1);
+    return seed;
+}
+
+std::string config_fingerprint(const experiment_config& config)
+{
+    std::ostringstream out;
+    out << "metric=" << option_name(config.metric, {"sqeuclidean", "l1", "linf"}, parse_metric)
+        << ";edges=" << option_name(config.edges, {"complete", "radius"}, parse_edge_mode);
+    if (config.edges == edge_mode::radius) out << ";radius-c=" << config.radius_c;
+    out << ";vertex-order=" << option_name(config.order, {"generation", "morton", "hilbert"}, parse_vertex_order)
+        << ";sort-kernel=" << sort_kernel_name(config.array_sort)
+        << ";alloc=" << option_name(config.allocator, {"system", "arena", "huge"}, parse_arena_mode)
+        << ";prefault=" << config.prefault
+        << ";kruskal-batch=" << config.kruskal_batch
+        << ";reconstruction-tree=" << config.reconstruction_tree;
+    return out.str();
+}
@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <limits>
+
+#include "../include/dynamic_mst.h"
+
+namespace {
+
+constexpr double VERTEX_WEIGHT = -std::numeric_limits<double>::infinity();
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// LinkCutTree
+// ---------------------------------------------------------------------------
+
+bool LinkCutTree::is_splay_root(int x) const
+{
+    int p = nodes[x].parent;
+    return p == -1 || (nodes[p].child[0] != x && nodes[p].child[1] != x);
+}
+
+void LinkCutTree::pull(int x)
+{
+    int best = x;
+    for (int c : nodes[x].child) {
+        if (c != -1 && nodes[nodes[c].max_node].weight > nodes[best].weight) best = nodes[c].max_node;
+    }
+    nodes[x].max_node = best;
+}
+
+void LinkCutTree::push(int x)
+{
+    if (!nodes[x].reversed) return;
+    std::swap(nodes[x].child[0], nodes[x].child[1]);
+    for (int c : nodes[x].child) {
+        if (c != -1) nodes[c].reversed = !nodes[c].reversed;
+    }
+    nodes[x].reversed = false;
+}
+
+void LinkCutTree::rotate(int x)
+{
+    int p = nodes[x].parent;
+    int g = nodes[p].parent;
+    int dir = nodes[p].child[1] == x;
+    int b = nodes[x].child[!dir];
+
+    if (!is_splay_root(p)) {
+        if (nodes[g].child[0] == p) nodes[g].child[0] = x;
+        else nodes[g].child[1] = x;
+    }
+    nodes[x].parent = g;
+    nodes[x].child[!dir] = p;
+    nodes[p].parent = x;
+    nodes[p].child[dir] = b;
+    if (b != -1) nodes[b].parent = p;
+    pull(p);
+    pull(x);
+}
+
+void LinkCutTree::splay(int x)
+{
+    // Propagar las inversiones pendientes desde la raíz del splay hacia x
+    std::vector<int> path = {x};
+    for (int y = x; !is_splay_root(y); y = nodes[y].parent) path.push_back(nodes[y].parent);
+    for (auto it = path.rbegin(); it != path.rend(); ++it) push(*it);
+
+    while (!is_splay_root(x)) {
+        int p = nodes[x].parent;
+        if (!is_splay_root(p)) {
+            int g = nodes[p].parent;
+            bool zigzig = (nodes[g].child[0] == p) == (nodes[p].child[0] == x);
+            rotate(zigzig ? p : x);
+        }
+        rotate(x);
+    }
+}
+
+void LinkCutTree::access(int x)
+{
+    int last = -1;
+    for (int y = x; y != -1; y = nodes[y].parent) {
+        splay(y);
+        nodes[y].child[1] = last;
+        pull(y);
+        last = y;
+    }
+    splay(x);
+}
+
+void LinkCutTree::make_root(int x)
+{
+    access(x);
+    nodes[x].reversed = !nodes[x].reversed;
+}
+
+int LinkCutTree::find_root(int x)
+{
+    access(x);
+    int y = x;
+    push(y);
+    while (nodes[y].child[0] != -1) {
+        y = nodes[y].child[0];
+        push(y);
+    }
+    splay(y);
+    return y;
+}
+
+int LinkCutTree::add_node(double weight)
+{
+    int x = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+    reset_node(x, weight);
+    return x;
+}
+
+void LinkCutTree::reset_node(int x, double weight)
+{
+    nodes[x] = lct_node{};
+    nodes[x].weight = weight;
+    nodes[x].max_node = x;
+}
+
+void LinkCutTree::link(int x, int y)
+{
+    make_root(x);
+    nodes[x].parent = y;
+}
+
+void LinkCutTree::cut(int x, int y)
+{
+    make_root(x);
+    access(y);
+    // y es la raíz del splay y x, adyacente, su único descendiente a la izquierda
+    nodes[y].child[0] = -1;
+    nodes[x].parent = -1;
+    pull(y);
+}
+
+bool LinkCutTree::connected(int x, int y)
+{
+    return x == y || find_root(x) == find_root(y);
+}
+
+int LinkCutTree::path_max(int x, int y)
+{
+    make_root(x);
+    access(y);
+    return nodes[y].max_node;
+}
+
+// ---------------------------------------------------------------------------
+// DynamicMST
+// ---------------------------------------------------------------------------
+
+DynamicMST::DynamicMST(int n)
+{
+    for (int i = 0; i < n; ++i) add_vertex();
+}
+
+uint64_t DynamicMST::key(int u, int v)
+{
+    if (u > v) std::swap(u, v);
+    return (static_cast<uint64_t>(static_cast<uint32_t>(u)) << 32) | static_cast<uint32_t>(v);
+}
+
+int DynamicMST::add_vertex()
+{
+    int v = static_cast<int>(vertex_node.size());
+    vertex_node.push_back(forest.add_node(VERTEX_WEIGHT));
+    alive.push_back(true);
+    adjacency.emplace_back();
+    tree_adjacency.emplace_back();
+    visit_mark.push_back(0);
+    return v;
+}
+
+int DynamicMST::insert_vertex(const std::vector<std::pair<int, double>>& candidates)
+{
+    int v = add_vertex();
+    for (const auto& [neighbor, weight] : candidates) insert_edge(v, neighbor, weight);
+    return v;
+}
+
+void DynamicMST::link_tree_edge(int u, int v, edge_info& info)
+{
+    int node;
+    if (!free_edge_nodes.empty()) {
+        node = free_edge_nodes.back();
+        free_edge_nodes.pop_back();
+        forest.reset_node(node, info.weight);
+    } else {
+        node = forest.add_node(info.weight);
+    }
+    if (node_edge.size() <= static_cast<size_t>(node)) node_edge.resize(node + 1);
+    node_edge[node] = {u, v};
+
+    forest.link(vertex_node[u], node);
+    forest.link(node, vertex_node[v]);
+    info.tree_node = node;
+    tree_adjacency[u].insert(v);
+    tree_adjacency[v].insert(u);
+    total_weight += info.weight;
+    tree_edge_count++;
+}
+
+void DynamicMST::cut_tree_edge(int u, int v, edge_info& info)
+{
+    forest.cut(vertex_node[u], info.tree_node);
+    forest.cut(info.tree_node, vertex_node[v]);
+    free_edge_nodes.push_back(info.tree_node);
+    info.tree_node = -1;
+    tree_adjacency[u].erase(v);
+    tree_adjacency[v].erase(u);
+    total_weight -= info.weight;
+    tree_edge_count--;
+}
+
+void DynamicMST::offer(int u, int v, edge_info& info)
+{
+    if (!forest.connected(vertex_node[u], vertex_node[v])) {
+        link_tree_edge(u, v, info);
+        return;
+    }
+    // La arista cierra un ciclo: entra si es más liviana que la más pesada del ciclo
+    int heaviest = forest.path_max(vertex_node[u], vertex_node[v]);
+    if (forest.weight(heaviest) <= info.weight) return;
+    auto [a, b] = node_edge[heaviest];
+    cut_tree_edge(a, b, edges.at(key(a, b)));
+    link_tree_edge(u, v, info);
+}
+
+void DynamicMST::find_replacement(int u, int v)
+{
+    // BFS alternado desde ambos extremos del corte: el primero que se agota es el lado chico
+    visit_stamp += 2;
+    const unsigned int stamp_u = visit_stamp;
+    const unsigned int stamp_v = visit_stamp + 1;
+    std::vector<int> side_u = {u};
+    std::vector<int> side_v = {v};
+    visit_mark[u] = stamp_u;
+    visit_mark[v] = stamp_v;
+    size_t next_u = 0;
+    size_t next_v = 0;
+
+    auto step = [&](std::vector<int>& side, size_t& next, unsigned int stamp) {
+        int x = side[next++];
+        for (int neighbor : tree_adjacency[x]) {
+            if (visit_mark[neighbor] != stamp) {
+                visit_mark[neighbor] = stamp;
+                side.push_back(neighbor);
+            }
+        }
+    };
+
+    const std::vector<int>* small = nullptr;
+    unsigned int small_stamp = 0;
+    while (!small) {
+        if (next_u == side_u.size()) { small = &side_u; small_stamp = stamp_u; break; }
+        step(side_u, next_u, stamp_u);
+        if (next_v == side_v.size()) { small = &side_v; small_stamp = stamp_v; break; }
+        step(side_v, next_v, stamp_v);
+    }
+
+    // Toda arista que sale del lado chico cruza el corte (en un bosque mínimo no hay
+    // aristas entre árboles distintos); se elige la más liviana
+    int best_a = -1;
+    int best_b = -1;
+    double best_weight = std::numeric_limits<double>::infinity();
+    for (int x : *small) {
+        for (int neighbor : adjacency[x]) {
+            if (visit_mark[neighbor] == small_stamp) continue;
+            double weight = edges.at(key(x, neighbor)).weight;
+            if (weight < best_weight) {
+                best_weight = weight;
+                best_a = x;
+                best_b = neighbor;
+            }
+        }
+    }
+    if (best_a != -1) link_tree_edge(best_a, best_b, edges.at(key(best_a, best_b)));
+}
+
+void DynamicMST::insert_edge(int u, int v, double weight)
+{
+    if (u == v || !alive[u] || !alive[v]) return;
+    auto found = edges.find(key(u, v));
+    if (found != edges.end()) {
+        update_weight(u, v, weight);
+        return;
+    }
+    edge_info& info = edges[key(u, v)] = {weight, -1};
+    adjacency[u].insert(v);
+    adjacency[v].insert(u);
+    offer(u, v, info);
+}
+
+void DynamicMST::update_weight(int u, int v, double weight)
+{
+    edge_info& info = edges.at(key(u, v));
+    const double old_weight = info.weight;
+    if (info.tree_node != -1) {
+        cut_tree_edge(u, v, info);
+        info.weight = weight;
+        if (weight <= old_weight) {
+            // Una arista del árbol que se abarata sigue siendo mínima
+            link_tree_edge(u, v, info);
+        } else {
+            // Se encarece: compite con las demás aristas que cruzan el corte (incluida ella)
+            find_replacement(u, v);
+        }
+    } else {
+        info.weight = weight;
+        if (weight < old_weight) offer(u, v, info);
+    }
+}
+
+void DynamicMST::delete_edge(int u, int v)
+{
+    auto found = edges.find(key(u, v));
+    if (found == edges.end()) return;
+    const bool was_tree = found->second.tree_node != -1;
+    if (was_tree) cut_tree_edge(u, v, found->second);
+    edges.erase(found);
+    adjacency[u].erase(v);
+    adjacency[v].erase(u);
+    if (was_tree) find_replacement(u, v);
+}
+
+void DynamicMST::delete_vertex(int v)
+{
+    // Primero las aristas fuera del árbol, para que los reemplazos no vuelvan a pasar por v
+    std::vector<int> neighbors(adjacency[v].begin(), adjacency[v].end());
+    std::stable_partition(neighbors.begin(), neighbors.end(),
+                          [&](int neighbor) { return !tree_adjacency[v].count(neighbor); });
+    for (int neighbor : neighbors) delete_edge(v, neighbor);
+    alive[v] = false;
+}
+
+bool DynamicMST::has_edge(int u, int v) const
+{
+    return edges.count(key(u, v)) > 0;
+}
+
+std::vector<edge> DynamicMST::tree_edges() const
+{
+    std::vector<edge> result;
+    result.reserve(tree_edge_count);
+    for (const auto& [k, info] : edges) {
+        if (info.tree_node != -1) result.emplace_back(static_cast<int>(k >> 32), static_cast<int>(k & 0xFFFFFFFF), info.weight);
+    }
+    return result;
+}
+
+std::vector<edge> DynamicMST::graph_edges() const
+{
+    std::vector<edge> result;
+    result.reserve(edges.size());
+    for (const auto& [k, info] : edges) {
+        result.emplace_back(static_cast<int>(k >> 32), static_cast<int>(k & 0xFFFFFFFF), info.weight);
+    }
+    return result;
+}
@@ -0,0 +1,25 @@
+#include "../include/edge_generation.h"
+#include "union_find.hpp"
+
+bool parse_edge_mode(const std::string& name, edge_mode& mode)
+{
+    if (name == "complete") { mode = edge_mode::complete; return true; }
+    if (name == "radius") { mode = edge_mode::radius; return true; }
+    return false;
+}
+
+bool edges_span(const edge_vector& edges, int num_nodes)
+{
+    if (num_nodes <= 1) return true;
+    UnionFind uf(num_nodes, true);
+    int components = num_nodes;
+    for (const edge& e : edges) {
+        int root_u = uf.find(e.u);
+        int root_v = uf.find(e.v);
+        if (root_u != root_v) {
+            uf.link(root_u, root_v);
+            if (--components == 1) return true;
+        }
+    }
+    return false;
+}
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <chrono>
+#include <algorithm>
+#include <limits>
+#include <memory>
 
 #include "../include/kruskal.h"
 #include "union_find.hpp"
@@ -13,12 +16,22 @@ struct ResultadoKruskal {
     std::vector<edge> aristas_mst;    ///< Aristas en el árbol cobertor mínimo
     double peso_total;                ///< Peso total del MST
     int num_nodos;                    ///< Número de nodos en el grafo
+    kruskal_stats stats;              ///< Contadores de instrumentación (KRUSKAL_STATS)
+    std::vector<int> original_ids;    ///< Id original de cada vértice (vacío si no se renumeró)
+    std::unique_ptr<KruskalReconstructionTree> krt; ///< Árbol de reconstrucción (si se pidió)
+    std::vector<int> etiquetas;       ///< Cluster (0..k-1) de cada vértice en modo k-clustering
+    double distancia_union = 0.0;     ///< Peso de la última unión realizada
     
-    ResultadoKruskal(int n) : peso_total(0.0), num_nodos(n) {
-        aristas_mst.reserve(n - 1);  // MST tiene exactamente n-1 aristas
+    ResultadoKruskal(int n, bool guardar_aristas = true) : peso_total(0.0), num_nodos(n) {
+        if (guardar_aristas) aristas_mst.reserve(n - 1);  // MST tiene exactamente n-1 aristas
     }
 };
 
+/**
+ * @brief Distancia, en aristas del lote, a la que se adelanta el prefetch del Union-Find
+ */
+constexpr size_t PREFETCH_DISTANCE = 8;
+
 /**
  * @brief Implementación del algoritmo de Kruskal
  * @param edge_extractor Puntero a estructura de extracción de aristas (heap o arreglo ordenado)
@@ -26,39 +39,139 @@ struct ResultadoKruskal {
  * @return Puntero a ResultadoKruskal conteniendo el MST
  */
 void* kruskal(EdgeExtractor *edge_extractor, const bool opti_path)
+{
+    return kruskal(edge_extractor, opti_path, kruskal_options{});
+}
+
+/**
+ * @brief Implementación del algoritmo de Kruskal con extracción por lotes
+ * @param edge_extractor Puntero a estructura de extracción de aristas (heap o arreglo ordenado)
+ * @param opti_path Si usar optimización path compression en Union-Find
+ * @param options Tamaño de lote y número de vértices
+ * @return Puntero a ResultadoKruskal conteniendo el MST
+ */
+void* kruskal(EdgeExtractor *edge_extractor, const bool opti_path, const kruskal_options& options)
 {
     if (!edge_extractor || edge_extractor->size() == 0) {
         return nullptr;
     }
+    const size_t batch_size = options.batch_size;
     
-    // Calcular número de nodos a partir del número de aristas
+    // Calcular número de nodos a partir del número de aristas si no se indicó
     // Para grafo completo: num_aristas = n*(n-1)/2, entonces n = (1 + sqrt(1 + 8*num_aristas))/2
     size_t num_aristas = edge_extractor->size();
-    int num_nodos = static_cast<int>((1 + std::sqrt(1 + 8.0 * num_aristas)) / 2.0);
+    int num_nodos = options.num_nodes > 0
+        ? options.num_nodes
+        : static_cast<int>((1 + std::sqrt(1 + 8.0 * num_aristas)) / 2.0);
     
     // Crear estructura de resultado
-    ResultadoKruskal* resultado = new ResultadoKruskal(num_nodos);
+    // En modo k-clustering no se guardan las aristas, solo las etiquetas al final
+    const bool modo_clusters = options.clusters > 0;
+    ResultadoKruskal* resultado = new ResultadoKruskal(num_nodos, !modo_clusters);
     
     // Crear estructura Union-Find basada en flag de optimización
-    IUnionFind* uf = new UnionFind(num_nodos, opti_path);
+    UnionFind* uf = new UnionFind(num_nodos, opti_path);
     
+    // Árbol de reconstrucción: nodo_componente[raíz] es el nodo que representa
+    // a ese componente; cada unión crea un nodo con el peso de la arista
+    std::vector<int> nodo_componente;
+    if (options.reconstruction_tree) {
+        resultado->krt = std::make_unique<KruskalReconstructionTree>(num_nodos);
+        nodo_componente.resize(num_nodos);
+        for (int i = 0; i < num_nodos; ++i) nodo_componente[i] = i;
+    }
+    auto registrar_union = [&](int raiz_u, int raiz_v, int raiz_nueva, double peso) {
+        nodo_componente[raiz_nueva] = resultado->krt->merge(nodo_componente[raiz_u], nodo_componente[raiz_v], peso);
+    };
+
     // Procesar aristas en orden de peso creciente
     int aristas_agregadas = 0;
-    const int aristas_objetivo = num_nodos - 1;  // MST tiene exactamente n-1 aristas
-    
-    while (aristas_agregadas < aristas_objetivo && edge_extractor->size() > 0) {
-        // Extraer arista de peso mínimo
-        edge arista_actual = edge_extractor->extract_min();
-        
-        // Verificar si agregar esta arista crearía un ciclo
-        if (!uf->connected(arista_actual.u, arista_actual.v)) {
-            // Agregar arista al MST
-            uf->unite(arista_actual.u, arista_actual.v);
-            resultado->aristas_mst.push_back(arista_actual);
-            resultado->peso_total += arista_actual.weight;
-            aristas_agregadas++;
+    // MST tiene exactamente n-1 aristas; para k clusters basta con n-k uniones
+    const int aristas_objetivo = modo_clusters ? std::max(0, num_nodos - options.clusters) : num_nodos - 1;
+
+    if (batch_size <= 1) {
+        while (aristas_agregadas < aristas_objetivo && edge_extractor->size() > 0) {
+            // Extraer arista de peso mínimo
+            edge arista_actual = edge_extractor->extract_min();
+            UF_STAT(resultado->stats.edges_extracted++;)
+
+            // Verificar si agregar esta arista crearía un ciclo
+            if (!uf->connected(arista_actual.u, arista_actual.v)) {
+                // Agregar arista al MST
+                if (options.reconstruction_tree) {
+                    int raiz_u = uf->find(arista_actual.u);
+                    int raiz_v = uf->find(arista_actual.v);
+                    registrar_union(raiz_u, raiz_v, uf->link(raiz_u, raiz_v), arista_actual.weight);
+                } else {
+                    uf->unite(arista_actual.u, arista_actual.v);
+                }
+                if (!modo_clusters) resultado->aristas_mst.push_back(arista_actual);
+                resultado->peso_total += arista_actual.weight;
+                resultado->distancia_union = arista_actual.weight;
+                aristas_agregadas++;
+                UF_STAT(resultado->stats.last_useful_edge = resultado->stats.edges_extracted - 1;)
+            }
+        }
+    } else {
+        std::vector<edge> lote(batch_size);
+        while (aristas_agregadas < aristas_objetivo) {
+            size_t en_lote = edge_extractor->extract_batch(lote.data(), batch_size);
+            if (en_lote == 0) break;
+
+            // Las primeras aristas del lote se piden a la caché antes de empezar
+            for (size_t i = 0; i < std::min(PREFETCH_DISTANCE, en_lote); ++i) {
+                uf->prefetch(lote[i].u);
+                uf->prefetch(lote[i].v);
+            }
+
+            for (size_t i = 0; i < en_lote && aristas_agregadas < aristas_objetivo; ++i) {
+                if (i + PREFETCH_DISTANCE < en_lote) {
+                    uf->prefetch(lote[i + PREFETCH_DISTANCE].u);
+                    uf->prefetch(lote[i + PREFETCH_DISTANCE].v);
+                }
+                const edge& arista_actual = lote[i];
+                UF_STAT(resultado->stats.edges_extracted++;)
+
+                // Las raíces del chequeo de ciclo se reutilizan para la unión
+                int raiz_u = uf->find(arista_actual.u);
+                int raiz_v = uf->find(arista_actual.v);
+                if (raiz_u != raiz_v) {
+                    int raiz_nueva = uf->link(raiz_u, raiz_v);
+                    if (options.reconstruction_tree) registrar_union(raiz_u, raiz_v, raiz_nueva, arista_actual.weight);
+                    if (!modo_clusters) resultado->aristas_mst.push_back(arista_actual);
+                    resultado->peso_total += arista_actual.weight;
+                    resultado->distancia_union = arista_actual.weight;
+                    aristas_agregadas++;
+                    UF_STAT(resultado->stats.last_useful_edge = resultado->stats.edges_extracted - 1;)
+                }
+            }
+        }
+    }
+
+    if (options.reconstruction_tree) {
+        resultado->krt->build_index();
+    }
+
+    // Etiquetas compactas: la i-ésima raíz distinta encontrada es el cluster i
+    if (modo_clusters) {
+        std::vector<int> etiqueta_raiz(num_nodos, -1);
+        int siguiente = 0;
+        resultado->etiquetas.resize(num_nodos);
+        for (int v = 0; v < num_nodos; ++v) {
+            int raiz = uf->find(v);
+            if (etiqueta_raiz[raiz] == -1) etiqueta_raiz[raiz] = siguiente++;
+            resultado->etiquetas[v] = etiqueta_raiz[raiz];
         }
     }
+
+#ifdef KRUSKAL_STATS
+    const union_find_stats& uf_stats = uf->get_stats();
+    resultado->stats.edges_accepted = aristas_agregadas;
+    resultado->stats.find_calls = uf_stats.find_calls;
+    resultado->stats.path_length_total = uf_stats.path_length_total;
+    resultado->stats.path_length_max = uf_stats.path_length_max;
+    resultado->stats.compressions = uf_stats.compressions;
+#endif
     
     // Limpiar estructura Union-Find
     delete uf;
@@ -95,3 +208,84 @@ int get_mst_edge_count(void* result) {
     if (!result) return 0;
     return static_cast<ResultadoKruskal*>(result)->aristas_mst.size();
 }
+
+/**
+ * @brief Función auxiliar para obtener los contadores de instrumentación
+ * @param result Puntero a ResultadoKruskal
+ * @return Contadores de la ejecución (en cero si no se compiló con KRUSKAL_STATS)
+ */
+kruskal_stats get_kruskal_stats(void* result) {
+    if (!result) return kruskal_stats{};
+    return static_cast<ResultadoKruskal*>(result)->stats;
+}
+
+/**
+ * @brief Asocia al resultado la numeración original de los vértices
+ * @param result Puntero a ResultadoKruskal
+ * @param original_ids original_ids[v] = id original del vértice v
+ */
+void set_vertex_mapping(void* result, const std::vector<int>& original_ids) {
+    if (!result) return;
+    static_cast<ResultadoKruskal*>(result)->original_ids = original_ids;
+}
+
+/**
+ * @brief Función auxiliar para obtener las aristas del MST con los ids originales
+ * @param result Puntero a ResultadoKruskal
+ * @return Aristas del MST en la numeración original
+ */
+std::vector<edge> get_mst_edges(void* result) {
+    if (!result) return {};
+    const ResultadoKruskal* resultado = static_cast<ResultadoKruskal*>(result);
+    std::vector<edge> aristas = resultado->aristas_mst;
+    if (!resultado->original_ids.empty()) {
+        for (edge& e : aristas) {
+            e.u = resultado->original_ids[e.u];
+            e.v = resultado->original_ids[e.v];
+        }
+    }
+    return aristas;
+}
+
+/**
+ * @brief Árbol de reconstrucción construido por kruskal()
+ * @param result Puntero a ResultadoKruskal
+ * @return Árbol con su índice LCA, o nullptr si no se pidió
+ */
+const KruskalReconstructionTree* get_reconstruction_tree(void* result) {
+    if (!result) return nullptr;
+    return static_cast<ResultadoKruskal*>(result)->krt.get();
+}
+
+/**
+ * @brief Distancia minimax entre dos vértices
+ * @param result Puntero a ResultadoKruskal
+ * @param u Primer vértice
+ * @param v Segundo vértice
+ * @return Peso de la arista cuello de botella
+ */
+double get_bottleneck_weight(void* result, int u, int v) {
+    const KruskalReconstructionTree* krt = get_reconstruction_tree(result);
+    if (!krt) return std::numeric_limits<double>::infinity();
+    return krt->bottleneck(u, v);
+}
+
+/**
+ * @brief Etiquetas de cluster de cada vértice (modo k-clustering)
+ * @param result Puntero a ResultadoKruskal
+ * @return Etiquetas en 0..k-1, o vacío si no se pidió k-clustering
+ */
+std::vector<int> get_cluster_labels(void* result) {
+    if (!result) return {};
+    return static_cast<ResultadoKruskal*>(result)->etiquetas;
+}
+
+/**
+ * @brief Peso de la última unión realizada
+ * @param result Puntero a ResultadoKruskal
+ * @return Distancia de la última unión (0 si no hubo uniones)
+ */
+double get_merge_distance(void* result) {
+    if (!result) return 0.0;
+    return static_cast<ResultadoKruskal*>(result)->distancia_union;
+}
@@ -0,0 +1,112 @@
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+
+#include <malloc.h>
+
+#include "../include/mem_tracker.h"
+
+/**
+ * Reemplazo de los operator new/delete globales que lleva la cuenta, por hilo,
+ * de asignaciones y bytes (medidos con malloc_usable_size). Los contadores son
+ * thread_local de inicialización constante, así que no necesitan constructor y
+ * se pueden usar incluso durante el arranque de un hilo.
+ */
+
+namespace {
+
+thread_local alloc_snapshot counters = {0, 0, 0, 0};
+
+inline void track_alloc(void* ptr)
+{
+    long long size = static_cast<long long>(malloc_usable_size(ptr));
+    counters.count++;
+    counters.bytes += size;
+    counters.live_bytes += size;
+    if (counters.live_bytes > counters.peak_live_bytes) counters.peak_live_bytes = counters.live_bytes;
+}
+
+inline void track_free(void* ptr)
+{
+    counters.live_bytes -= static_cast<long long>(malloc_usable_size(ptr));
+}
+
+void* tracked_malloc(std::size_t size, std::size_t alignment, bool nothrow)
+{
+    if (size == 0) size = 1;
+    void* ptr;
+    if (alignment <= alignof(std::max_align_t)) {
+        ptr = std::malloc(size);
+    } else {
+        // aligned_alloc exige un tamaño múltiplo del alineamiento
+        ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+    if (!ptr) {
+        if (nothrow) return nullptr;
+        throw std::bad_alloc();
+    }
+    track_alloc(ptr);
+    return ptr;
+}
+
+void tracked_free(void* ptr)
+{
+    if (!ptr) return;
+    track_free(ptr);
+    std::free(ptr);
+}
+
+} // namespace
+
+alloc_snapshot thread_allocations()
+{
+    return counters;
+}
+
+void reset_thread_peak()
+{
+    counters.peak_live_bytes = counters.live_bytes;
+}
+
+long peak_rss_kb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) return std::stol(line.substr(6));
+    }
+    return -1;
+}
+
+bool reset_peak_rss()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (!clear_refs.is_open()) return false;
+    clear_refs << "5";
+    clear_refs.flush();
+    return clear_refs.good();
+}
+
+void* operator new(std::size_t size) { return tracked_malloc(size, 0, false); }
+void* operator new[](std::size_t size) { return tracked_malloc(size, 0, false); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return tracked_malloc(size, 0, true); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return tracked_malloc(size, 0, true); }
+void* operator new(std::size_t size, std::align_val_t al) { return tracked_malloc(size, static_cast<std::size_t>(al), false); }
+void* operator new[](std::size_t size, std::align_val_t al) { return tracked_malloc(size, static_cast<std::size_t>(al), false); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return tracked_malloc(size, static_cast<std::size_t>(al), true); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return tracked_malloc(size, static_cast<std::size_t>(al), true); }
+
+void operator delete(void* ptr) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { tracked_free(ptr); }
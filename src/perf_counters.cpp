@@ -0,0 +1,105 @@
+#include <cstdint>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../include/perf_counters.h"
+
+namespace {
+
+/**
+ * @brief Configuración (type, config) de cada contador de perf_event_kind
+ */
+struct perf_event_spec
+{
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cache_miss_config(uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr perf_event_spec EVENT_SPECS[PERF_EVENT_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_miss_config(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cache_miss_config(PERF_COUNT_HW_CACHE_DTLB)},
+};
+
+int open_event(const perf_event_spec& spec)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1; // Permite usarlo con perf_event_paranoid = 2
+    attr.exclude_hv = 1;
+    // Los hilos que lance el hilo (p.ej. los de RunMerge::prepare()) suman al contador al
+    // terminar; el kernel no lo admite con PERF_FORMAT_GROUP, que no se usa
+    attr.inherit = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // pid = 0, cpu = -1: el hilo actual (y los que cree) en cualquier CPU
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters()
+{
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+        fds[i] = open_event(EVENT_SPECS[i]);
+    }
+}
+
+bool PerfCounters::available() const
+{
+    for (int fd : fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+void PerfCounters::start()
+{
+    for (int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+perf_sample PerfCounters::stop()
+{
+    perf_sample sample;
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i) {
+        if (fds[i] < 0) continue;
+        ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        // Formato de lectura: valor, tiempo habilitado, tiempo corriendo
+        uint64_t data[3] = {0, 0, 0};
+        if (read(fds[i], data, sizeof(data)) != sizeof(data)) continue;
+        if (data[2] == 0) continue; // El contador nunca llegó a correr
+
+        // Escalar si el kernel multiplexó los contadores
+        double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        sample.value[i] = static_cast<unsigned long long>(data[0] * scale);
+        sample.valid[i] = true;
+    }
+    return sample;
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
@@ -0,0 +1,121 @@
+#include <limits>
+#include <utility>
+
+#include "../include/reconstruction_tree.h"
+
+KruskalReconstructionTree::KruskalReconstructionTree(int n)
+    : num_leaves(n), parent(n, -1), weight(n, 0.0)
+{
+    parent.reserve(2 * n);
+    weight.reserve(2 * n);
+}
+
+int KruskalReconstructionTree::merge(int a, int b, double w)
+{
+    int node = static_cast<int>(parent.size());
+    parent.push_back(-1);
+    weight.push_back(w);
+    parent[a] = node;
+    parent[b] = node;
+    return node;
+}
+
+void KruskalReconstructionTree::build_index()
+{
+    const int nodes = size();
+
+    // Hijos en formato CSR para recorrer sin recursión
+    std::vector<int> child_start(nodes + 1, 0);
+    for (int x = 0; x < nodes; ++x) {
+        if (parent[x] != -1) child_start[parent[x] + 1]++;
+    }
+    for (int x = 0; x < nodes; ++x) child_start[x + 1] += child_start[x];
+    std::vector<int> children(child_start[nodes]);
+    std::vector<int> fill(child_start.begin(), child_start.end() - 1);
+    for (int x = 0; x < nodes; ++x) {
+        if (parent[x] != -1) children[fill[parent[x]]++] = x;
+    }
+
+    first_seen.assign(nodes, -1);
+    tree_of.assign(nodes, -1);
+    euler_node.clear();
+    euler_depth.clear();
+    euler_node.reserve(2 * nodes);
+    euler_depth.reserve(2 * nodes);
+
+    // Recorrido de Euler de cada árbol del bosque: se anota un nodo al entrar y al volver de cada hijo
+    std::vector<std::pair<int, int>> stack; // (nodo, siguiente hijo)
+    for (int root = 0; root < nodes; ++root) {
+        if (parent[root] != -1) continue;
+        stack.push_back({root, child_start[root]});
+        tree_of[root] = root;
+        first_seen[root] = static_cast<int>(euler_node.size());
+        euler_node.push_back(root);
+        euler_depth.push_back(0);
+        while (!stack.empty()) {
+            auto& [x, next] = stack.back();
+            if (next < child_start[x + 1]) {
+                int c = children[next++];
+                int depth = static_cast<int>(stack.size());
+                tree_of[c] = root;
+                first_seen[c] = static_cast<int>(euler_node.size());
+                euler_node.push_back(c);
+                euler_depth.push_back(depth);
+                stack.push_back({c, child_start[c]});
+            } else {
+                stack.pop_back();
+                if (!stack.empty()) {
+                    euler_node.push_back(stack.back().first);
+                    euler_depth.push_back(static_cast<int>(stack.size()) - 1);
+                }
+            }
+        }
+    }
+
+    // Sparse table de posiciones con profundidad mínima
+    const int length = static_cast<int>(euler_node.size());
+    log2_floor.assign(length + 1, 0);
+    for (int i = 2; i <= length; ++i) log2_floor[i] = log2_floor[i / 2] + 1;
+    sparse.assign(log2_floor[length] + 1, {});
+    sparse[0].resize(length);
+    for (int i = 0; i < length; ++i) sparse[0][i] = i;
+    for (size_t j = 1; j < sparse.size(); ++j) {
+        const int span = 1 << j;
+        sparse[j].resize(length - span + 1);
+        for (int i = 0; i + span <= length; ++i) {
+            int left = sparse[j - 1][i];
+            int right = sparse[j - 1][i + span / 2];
+            sparse[j][i] = euler_depth[left] <= euler_depth[right] ? left : right;
+        }
+    }
+}
+
+int KruskalReconstructionTree::lca(int u, int v) const
+{
+    if (tree_of[u] != tree_of[v]) return -1;
+    int left = first_seen[u];
+    int right = first_seen[v];
+    if (left > right) std::swap(left, right);
+    const int j = log2_floor[right - left + 1];
+    int a = sparse[j][left];
+    int b = sparse[j][right - (1 << j) + 1];
+    return euler_node[euler_depth[a] <= euler_depth[b] ? a : b];
+}
+
+double KruskalReconstructionTree::bottleneck(int u, int v) const
+{
+    if (u == v) return 0.0;
+    int ancestor = lca(u, v);
+    if (ancestor == -1) return std::numeric_limits<double>::infinity();
+    return weight[ancestor];
+}
+
+size_t KruskalReconstructionTree::memory_bytes() const
+{
+    size_t bytes = parent.capacity() * sizeof(int) + weight.capacity() * sizeof(double)
+                 + first_seen.capacity() * sizeof(int) + tree_of.capacity() * sizeof(int)
+                 + euler_depth.capacity() * sizeof(int) + euler_node.capacity() * sizeof(int)
+                 + log2_floor.capacity() * sizeof(int);
+    for (const auto& level : sparse) bytes += level.capacity() * sizeof(int);
+    return bytes;
+}
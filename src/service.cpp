@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../include/service.h"
+#include "../include/arena.h"
+#include "../include/auto_extractor.h"
+#include "../include/edge_generation.h"
+#include "../include/kruskal.h"
+#include "../include/spatial_order.h"
+
+namespace {
+
+// Límites de una petición: evitan que un N o M absurdo agote la memoria del servicio
+constexpr size_t MAX_REQUEST_NODES = size_t(1) << 24;
+constexpr size_t MAX_REQUEST_EDGES = size_t(1) << 28;
+
+std::atomic<bool> stopping{false};
+int listen_fd = -1;
+
+/**
+ * @brief Estado de un hilo del servicio, reutilizado entre peticiones
+ */
+class service_worker
+{
+    const experiment_config& config;
+    std::vector<node> nodes;                   ///< Puntos de la petición actual
+    std::vector<int> original_ids;             ///< Ids de entrada cuando --vertex-order renumera los puntos
+    edge_vector edges;                         ///< Aristas de la petición actual
+    std::unique_ptr<EdgeExtractor> extractor;  ///< Extractor reutilizable (nulo con Auto, que elige por petición)
+
+    /**
+     * @brief Escribe "error MENSAJE"; la conexión se cierra después
+     */
+    bool fail(FILE* out, const std::string& message)
+    {
+        std::fprintf(out, "error %s\n", message.c_str());
+        std::fflush(out);
+        return false;
+    }
+
+    bool read_points(FILE* in, size_t& num_nodes, std::string& error)
+    {
+        unsigned long long n = 0;
+        if (std::fscanf(in, "%llu", &n) != 1 || n == 0 || n > MAX_REQUEST_NODES) {
+            error = "points requiere 1 <= N <= " + std::to_string(MAX_REQUEST_NODES);
+            return false;
+        }
+        if (config.edges == edge_mode::complete && n * (n - 1) / 2 > MAX_REQUEST_EDGES) {
+            error = "demasiados puntos para un grafo completo (usar --edges radius)";
+            return false;
+        }
+        nodes.clear();
+        nodes.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            node p;
+            // Una coordenada nan/inf daría pesos NaN, que el ordenamiento no admite
+            if (std::fscanf(in, "%lf %lf", &p.x, &p.y) != 2 || !std::isfinite(p.x) || !std::isfinite(p.y)) {
+                error = "punto " + std::to_string(i) + " inválido";
+                return false;
+            }
+            nodes.push_back(p);
+        }
+
+        original_ids.clear();
+        if (config.order != vertex_order::generation) original_ids = reorder_vertices(nodes, config.order);
+
+        edges.clear();
+        with_metric(config.metric, [&](auto metric) {
+            using Metric = decltype(metric);
+            if (config.edges == edge_mode::radius) {
+                generate_spanning_radius_edges<Metric>(nodes, config.radius_c, edges);
+            } else {
+                generate_complete_edges<Metric>(nodes, edges);
+            }
+        });
+        num_nodes = n;
+        return true;
+    }
+
+    bool read_edges(FILE* in, size_t& num_nodes, std::string& error)
+    {
+        unsigned long long n = 0, m = 0;
+        if (std::fscanf(in, "%llu %llu", &n, &m) != 2 || n == 0 || n > MAX_REQUEST_NODES || m > MAX_REQUEST_EDGES) {
+            error = "edges requiere 1 <= N <= " + std::to_string(MAX_REQUEST_NODES) + " y M <= " + std::to_string(MAX_REQUEST_EDGES);
+            return false;
+        }
+        original_ids.clear();
+        edges.clear();
+        edges.reserve(m);
+        for (size_t i = 0; i < m; ++i) {
+            long long u = 0, v = 0;
+            double w = 0;
+            if (std::fscanf(in, "%lld %lld %lf", &u, &v, &w) != 3 || u < 0 || v < 0
+                || u >= static_cast<long long>(n) || v >= static_cast<long long>(n) || !(w >= 0) || std::isinf(w)) {
+                error = "arista " + std::to_string(i) + " inválida";
+                return false;
+            }
+            edges.emplace_back(static_cast<int>(u), static_cast<int>(v), w);
+        }
+        num_nodes = n;
+        return true;
+    }
+
+    void solve(FILE* out, size_t num_nodes)
+    {
+        std::unique_ptr<EdgeExtractor> per_request;
+        EdgeExtractor* active = extractor.get();
+        if (!active) {
+            // Auto decide según el tamaño de cada instancia
+            per_request.reset(make_edge_extractor(config.extractors.front(), make_hint(num_nodes, edges.size()), config.cost_model_path));
+            active = per_request.get();
+        }
+
+        active->clear();
+        active->reserve(edges.size());
+        for (const edge& e : edges) active->insert_edge(e);
+        active->prepare();
+
+        void* result = kruskal(active, config.opti_paths.front(),
+                               kruskal_options{config.kruskal_batch, static_cast<int>(num_nodes)});
+        set_vertex_mapping(result, original_ids);
+        const std::vector<edge> mst = get_mst_edges(result);
+        std::fprintf(out, "ok %.17g %zu\n", get_mst_weight(result), mst.size());
+        for (const edge& e : mst) std::fprintf(out, "%d %d %.17g\n", e.u, e.v, e.weight);
+        std::fflush(out);
+        free_kruskal_result(result);
+    }
+
+    extraction_hint make_hint(size_t num_nodes, size_t num_edges) const
+    {
+        extraction_hint hint;
+        hint.num_edges = num_edges;
+        hint.consumed_fraction = estimate_consumed_fraction(num_nodes, num_edges);
+        hint.threads = std::max(1u, std::thread::hardware_concurrency() / config.max_threads);
+        return hint;
+    }
+
+public:
+    explicit service_worker(const experiment_config& config) : config(config)
+    {
+        if (config.extractors.front() != AUTO_EXTRACTOR_NAME) {
+            extractor.reset(make_edge_extractor(config.extractors.front(), make_hint(0, 0), config.cost_model_path));
+        }
+    }
+
+    /**
+     * @brief Atiende una petición
+     * @return false si la conexión debe cerrarse (EOF, quit, shutdown o error)
+     */
+    bool serve_request(FILE* in, FILE* out)
+    {
+        char command[16];
+        if (std::fscanf(in, "%15s", command) != 1) return false;
+        const std::string cmd = command;
+        if (cmd == "quit") return false;
+        if (cmd == "shutdown") {
+            stopping = true;
+            // Despierta a los hilos bloqueados en accept()
+            if (listen_fd >= 0) ::shutdown(listen_fd, SHUT_RDWR);
+            return false;
+        }
+
+        size_t num_nodes = 0;
+        std::string error;
+        bool ok;
+        if (cmd == "points") {
+            ok = read_points(in, num_nodes, error);
+        } else if (cmd == "edges") {
+            ok = read_edges(in, num_nodes, error);
+        } else {
+            ok = false;
+            error = "comando desconocido '" + cmd + "'";
+        }
+        if (!ok) return fail(out, error);
+
+        try {
+            solve(out, num_nodes);
+        } catch (const std::bad_alloc&) {
+            return fail(out, "memoria insuficiente");
+        }
+        return true;
+    }
+
+    void serve(FILE* in, FILE* out)
+    {
+        while (serve_request(in, out)) {}
+    }
+};
+
+void unix_worker(const experiment_config& config)
+{
+    thread_arena().configure(config.allocator, config.prefault);
+    service_worker state(config);
+
+    while (!stopping) {
+        const int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;
+        }
+        FILE* in = fdopen(fd, "r");
+        FILE* out = fdopen(dup(fd), "w");
+        if (in && out) state.serve(in, out);
+        if (out) std::fclose(out);
+        if (in) std::fclose(in);
+        else ::close(fd);
+    }
+}
+
+int serve_unix(const experiment_config& config, const std::string& path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: ruta de socket inválida '" << path << "'" << std::endl;
+        return 1;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(path.c_str());
+    if (listen_fd < 0 || ::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listen_fd, SOMAXCONN) != 0) {
+        std::cerr << "Error: no se pudo escuchar en " << path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    std::cerr << "Servicio MST escuchando en " << path << " con " << config.max_threads << " hilos" << std::endl;
+
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned int i = 0; i < config.max_threads; ++i) workers.emplace_back(unix_worker, std::cref(config));
+    }
+
+    ::close(listen_fd);
+    listen_fd = -1;
+    ::unlink(path.c_str());
+    std::cerr << "Servicio MST detenido" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int run_service(const experiment_config& config)
+{
+    // Un cliente que se desconecta a mitad de una respuesta no debe terminar el proceso
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (config.extractors.front() == AUTO_EXTRACTOR_NAME) shared_cost_model(config.cost_model_path);
+
+    if (config.serve.rfind(SERVICE_UNIX_PREFIX, 0) == 0) {
+        return serve_unix(config, config.serve.substr(SERVICE_UNIX_PREFIX.size()));
+    }
+
+    thread_arena().configure(config.allocator, config.prefault);
+    service_worker state(config);
+    state.serve(stdin, stdout);
+    return 0;
+}
@@ -0,0 +1,370 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "../include/simd_sort.h"
+
+namespace {
+
+std::atomic<sort_kernel> current_kernel{sort_kernel::automatic};
+
+sort_kernel resolve(sort_kernel kernel)
+{
+    if (kernel == sort_kernel::automatic) {
+        return sort_kernel_supported(sort_kernel::avx2) ? sort_kernel::avx2 : sort_kernel::std_sort;
+    }
+    return sort_kernel_supported(kernel) ? kernel : sort_kernel::std_sort;
+}
+
+void sort_scalar(std::vector<double>& keys, std::vector<uint32_t>& index)
+{
+    struct pair
+    {
+        double key;
+        uint32_t index;
+    };
+    std::vector<pair> pairs(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) pairs[i] = {keys[i], index[i]};
+    std::sort(pairs.begin(), pairs.end(), [](const pair& a, const pair& b) { return a.key < b.key; });
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = pairs[i].key;
+        index[i] = pairs[i].index;
+    }
+}
+
+#if defined(__x86_64__)
+/**
+ * Kernel AVX2: cada registro lleva 4 claves (double) y sus 4 índices extendidos a
+ * 64 bits, de modo que ambos se mueven con las mismas máscaras y permutaciones.
+ * Los bloques de 16 se ordenan en registros (red de 4 elementos por columna,
+ * transposición y mezclas bitónicas); luego se mezclan corridas en memoria con el
+ * kernel de mezcla bitónica de 8+8, duplicando el largo en cada pasada.
+ */
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+struct lanes
+{
+    __m256d key;
+    __m256i index;
+};
+
+AVX2_TARGET inline lanes load4(const double* keys, const uint32_t* index)
+{
+    return {_mm256_loadu_pd(keys), _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(index)))};
+}
+
+AVX2_TARGET inline void store4(double* keys, uint32_t* index, const lanes& v)
+{
+    _mm256_storeu_pd(keys, v.key);
+    const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    __m256i packed = _mm256_permutevar8x32_epi32(v.index, low_halves);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(index), _mm256_castsi256_si128(packed));
+}
+
+/**
+ * @brief Intercambio condicional entre registros: a queda con los mínimos, b con los máximos
+ */
+AVX2_TARGET inline void compare_exchange(lanes& a, lanes& b)
+{
+    __m256d swap = _mm256_cmp_pd(b.key, a.key, _CMP_LT_OQ);
+    __m256i swap_index = _mm256_castpd_si256(swap);
+    __m256d low = _mm256_min_pd(a.key, b.key);
+    __m256d high = _mm256_max_pd(a.key, b.key);
+    __m256i low_index = _mm256_blendv_epi8(a.index, b.index, swap_index);
+    __m256i high_index = _mm256_blendv_epi8(b.index, a.index, swap_index);
+    a = {low, low_index};
+    b = {high, high_index};
+}
+
+AVX2_TARGET inline lanes reverse(const lanes& v)
+{
+    return {_mm256_permute4x64_pd(v.key, 0x1B), _mm256_permute4x64_epi64(v.index, 0x1B)};
+}
+
+/**
+ * @brief Paso de limpieza bitónica dentro de un registro
+ * partner es v con los carriles permutados; los carriles de max_lanes se quedan con
+ * el mayor de cada par y el resto con el menor.
+ */
+AVX2_TARGET inline lanes exchange_with(const lanes& v, const lanes& partner, __m256d max_lanes)
+{
+    __m256d partner_less = _mm256_cmp_pd(partner.key, v.key, _CMP_LT_OQ);
+    __m256d partner_greater = _mm256_cmp_pd(partner.key, v.key, _CMP_GT_OQ);
+    __m256d take = _mm256_blendv_pd(partner_less, partner_greater, max_lanes);
+    return {_mm256_blendv_pd(v.key, partner.key, take),
+            _mm256_blendv_epi8(v.index, partner.index, _mm256_castpd_si256(take))};
+}
+
+/**
+ * @brief Ordena un registro bitónico (distancias 2 y 1)
+ */
+AVX2_TARGET inline void bitonic_clean4(lanes& v)
+{
+    const __m256d upper_half = _mm256_castsi256_pd(_mm256_setr_epi64x(0, 0, -1, -1));
+    const __m256d odd_lanes = _mm256_castsi256_pd(_mm256_setr_epi64x(0, -1, 0, -1));
+    lanes halves = {_mm256_permute4x64_pd(v.key, 0x4E), _mm256_permute4x64_epi64(v.index, 0x4E)};
+    v = exchange_with(v, halves, upper_half);
+    lanes pairs = {_mm256_permute_pd(v.key, 0x5),
+                   _mm256_castpd_si256(_mm256_permute_pd(_mm256_castsi256_pd(v.index), 0x5))};
+    v = exchange_with(v, pairs, odd_lanes);
+}
+
+/**
+ * @brief Mezcla dos registros ordenados: a queda con los 4 menores y b con los 4 mayores, ambos ordenados
+ */
+AVX2_TARGET inline void merge4x4(lanes& a, lanes& b)
+{
+    b = reverse(b);
+    compare_exchange(a, b);
+    bitonic_clean4(a);
+    bitonic_clean4(b);
+}
+
+AVX2_TARGET inline void transpose_pd(__m256d& a, __m256d& b, __m256d& c, __m256d& d)
+{
+    __m256d t0 = _mm256_unpacklo_pd(a, b);
+    __m256d t1 = _mm256_unpackhi_pd(a, b);
+    __m256d t2 = _mm256_unpacklo_pd(c, d);
+    __m256d t3 = _mm256_unpackhi_pd(c, d);
+    a = _mm256_permute2f128_pd(t0, t2, 0x20);
+    b = _mm256_permute2f128_pd(t1, t3, 0x20);
+    c = _mm256_permute2f128_pd(t0, t2, 0x31);
+    d = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+
+/**
+ * @brief Transpone 4 registros: la columna j pasa a ser el registro j
+ */
+AVX2_TARGET inline void transpose(lanes& r0, lanes& r1, lanes& r2, lanes& r3)
+{
+    transpose_pd(r0.key, r1.key, r2.key, r3.key);
+    __m256d i0 = _mm256_castsi256_pd(r0.index), i1 = _mm256_castsi256_pd(r1.index);
+    __m256d i2 = _mm256_castsi256_pd(r2.index), i3 = _mm256_castsi256_pd(r3.index);
+    transpose_pd(i0, i1, i2, i3);
+    r0.index = _mm256_castpd_si256(i0);
+    r1.index = _mm256_castpd_si256(i1);
+    r2.index = _mm256_castpd_si256(i2);
+    r3.index = _mm256_castpd_si256(i3);
+}
+
+/**
+ * @brief Ordena en el lugar un bloque de 16 pares
+ */
+AVX2_TARGET void sort_block16(double* keys, uint32_t* index)
+{
+    lanes r0 = load4(keys, index), r1 = load4(keys + 4, index + 4);
+    lanes r2 = load4(keys + 8, index + 8), r3 = load4(keys + 12, index + 12);
+    // Red óptima de 4 elementos aplicada a las 4 columnas a la vez
+    compare_exchange(r0, r1);
+    compare_exchange(r2, r3);
+    compare_exchange(r0, r2);
+    compare_exchange(r1, r3);
+    compare_exchange(r1, r2);
+    transpose(r0, r1, r2, r3);
+    // Cuatro corridas de 4 -> dos de 8 -> una de 16
+    merge4x4(r0, r1);
+    merge4x4(r2, r3);
+    lanes b0 = reverse(r3), b1 = reverse(r2);
+    compare_exchange(r0, b0);
+    compare_exchange(r1, b1);
+    compare_exchange(r0, r1);
+    bitonic_clean4(r0);
+    bitonic_clean4(r1);
+    compare_exchange(b0, b1);
+    bitonic_clean4(b0);
+    bitonic_clean4(b1);
+    store4(keys, index, r0);
+    store4(keys + 4, index + 4, r1);
+    store4(keys + 8, index + 8, b0);
+    store4(keys + 12, index + 12, b1);
+}
+
+/**
+ * @brief Ordena 8 elementos bitónicos repartidos en dos registros
+ */
+AVX2_TARGET inline void bitonic_clean8(lanes& low, lanes& high)
+{
+    compare_exchange(low, high);
+    bitonic_clean4(low);
+    bitonic_clean4(high);
+}
+
+/**
+ * @brief Mezcla dos corridas de 8 en registros: (a0, a1) quedan con los 8 menores y (b0, b1) con los 8 mayores
+ */
+AVX2_TARGET inline void merge8x8(lanes& a0, lanes& a1, lanes& b0, lanes& b1)
+{
+    lanes r0 = reverse(b1), r1 = reverse(b0);
+    compare_exchange(a0, r0);
+    compare_exchange(a1, r1);
+    bitonic_clean8(a0, a1);
+    bitonic_clean8(r0, r1);
+    b0 = r0;
+    b1 = r1;
+}
+
+/**
+ * @brief Mezcla dos corridas ordenadas (largos múltiplos de 8) en out
+ * Se guardan en registros los 8 mayores pendientes; en cada paso se carga el
+ * siguiente bloque de 8 de la corrida cuya cabeza es menor y se mezcla con ellos.
+ */
+AVX2_TARGET void merge_runs(const double* ka, const uint32_t* ia, size_t la,
+                            const double* kb, const uint32_t* ib, size_t lb,
+                            double* kout, uint32_t* iout)
+{
+    if (lb == 0) {
+        std::copy(ka, ka + la, kout);
+        std::copy(ia, ia + la, iout);
+        return;
+    }
+    lanes c0 = load4(ka, ia), c1 = load4(ka + 4, ia + 4);
+    lanes n0 = load4(kb, ib), n1 = load4(kb + 4, ib + 4);
+    size_t pa = 8, pb = 8, po = 0;
+    while (true) {
+        merge8x8(c0, c1, n0, n1);
+        store4(kout + po, iout + po, c0);
+        store4(kout + po + 4, iout + po + 4, c1);
+        po += 8;
+        c0 = n0;
+        c1 = n1;
+        if (pa >= la && pb >= lb) break;
+        const bool from_a = pb >= lb || (pa < la && ka[pa] < kb[pb]);
+        const double* ksrc = from_a ? ka + pa : kb + pb;
+        const uint32_t* isrc = from_a ? ia + pa : ib + pb;
+        (from_a ? pa : pb) += 8;
+        n0 = load4(ksrc, isrc);
+        n1 = load4(ksrc + 4, isrc + 4);
+    }
+    store4(kout + po, iout + po, c0);
+    store4(kout + po + 4, iout + po + 4, c1);
+}
+
+/**
+ * @brief Pasadas de mezcla sobre [begin, end) desde corridas de largo width hasta max_width
+ * @return true si el resultado quedó en los arreglos tmp y no en los originales
+ */
+AVX2_TARGET bool merge_passes(double* keys, uint32_t* index, double* keys_tmp, uint32_t* index_tmp,
+                              size_t begin, size_t end, size_t width, size_t max_width)
+{
+    double* ksrc = keys;
+    uint32_t* isrc = index;
+    double* kdst = keys_tmp;
+    uint32_t* idst = index_tmp;
+    bool in_tmp = false;
+    for (; width < max_width && width < end - begin; width *= 2) {
+        for (size_t start = begin; start < end; start += 2 * width) {
+            const size_t mid = std::min(start + width, end);
+            const size_t stop = std::min(start + 2 * width, end);
+            merge_runs(ksrc + start, isrc + start, mid - start, ksrc + mid, isrc + mid, stop - mid,
+                       kdst + start, idst + start);
+        }
+        std::swap(ksrc, kdst);
+        std::swap(isrc, idst);
+        in_tmp = !in_tmp;
+    }
+    return in_tmp;
+}
+
+AVX2_TARGET void sort_avx2(std::vector<double>& keys, std::vector<uint32_t>& index, sort_scratch& scratch)
+{
+    // Pares por trozo ordenado completo antes de las pasadas globales: claves,
+    // índices y sus copias temporales (~384 KB) caben en L2
+    constexpr size_t CACHE_CHUNK = size_t(1) << 14;
+
+    const size_t n = keys.size();
+    // Relleno con +infinito hasta un múltiplo de 16: todas las corridas quedan de largo múltiplo de 8
+    const size_t padded = (n + 15) / 16 * 16;
+    keys.resize(padded, std::numeric_limits<double>::infinity());
+    index.resize(padded, 0);
+    std::vector<double>& keys_tmp = scratch.keys;
+    std::vector<uint32_t>& index_tmp = scratch.index;
+    keys_tmp.resize(padded);
+    index_tmp.resize(padded);
+
+    for (size_t begin = 0; begin < padded; begin += CACHE_CHUNK) {
+        const size_t end = std::min(begin + CACHE_CHUNK, padded);
+        for (size_t i = begin; i < end; i += 16) sort_block16(keys.data() + i, index.data() + i);
+        if (merge_passes(keys.data(), index.data(), keys_tmp.data(), index_tmp.data(), begin, end, 16, CACHE_CHUNK)) {
+            std::copy(keys_tmp.begin() + begin, keys_tmp.begin() + end, keys.begin() + begin);
+            std::copy(index_tmp.begin() + begin, index_tmp.begin() + end, index.begin() + begin);
+        }
+    }
+    if (merge_passes(keys.data(), index.data(), keys_tmp.data(), index_tmp.data(), 0, padded, CACHE_CHUNK, padded)) {
+        keys.swap(keys_tmp);
+        index.swap(index_tmp);
+    }
+    keys.resize(n);
+    index.resize(n);
+}
+#endif
+
+} // namespace
+
+bool parse_sort_kernel(const std::string& name, sort_kernel& kernel)
+{
+    if (name == "auto") { kernel = sort_kernel::automatic; return true; }
+    if (name == "std") { kernel = sort_kernel::std_sort; return true; }
+    if (name == "scalar") { kernel = sort_kernel::scalar; return true; }
+    if (name == "avx2") { kernel = sort_kernel::avx2; return true; }
+    return false;
+}
+
+std::string sort_kernel_name(sort_kernel kernel)
+{
+    switch (kernel) {
+    case sort_kernel::automatic: return "auto";
+    case sort_kernel::std_sort: return "std";
+    case sort_kernel::scalar: return "scalar";
+    case sort_kernel::avx2: return "avx2";
+    }
+    return "auto";
+}
+
+bool sort_kernel_supported(sort_kernel kernel)
+{
+#if defined(__x86_64__)
+    if (kernel == sort_kernel::avx2) return __builtin_cpu_supports("avx2");
+    return true;
+#else
+    // Sin x86-64 el kernel AVX2 no se compila: auto y avx2 caen en std
+    return kernel != sort_kernel::avx2;
+#endif
+}
+
+void set_sort_kernel(sort_kernel kernel)
+{
+    current_kernel.store(resolve(kernel), std::memory_order_relaxed);
+}
+
+sort_kernel active_sort_kernel()
+{
+    sort_kernel kernel = current_kernel.load(std::memory_order_relaxed);
+    if (kernel == sort_kernel::automatic) {
+        kernel = resolve(kernel);
+        current_kernel.store(kernel, std::memory_order_relaxed);
+    }
+    return kernel;
+}
+
+void sort_key_index(std::vector<double>& keys, std::vector<uint32_t>& index, sort_kernel kernel)
+{
+    sort_scratch scratch;
+    sort_key_index(keys, index, kernel, scratch);
+}
+
+void sort_key_index(std::vector<double>& keys, std::vector<uint32_t>& index, sort_kernel kernel, sort_scratch& scratch)
+{
+#if defined(__x86_64__)
+    if (kernel == sort_kernel::avx2 && sort_kernel_supported(kernel)) {
+        sort_avx2(keys, index, scratch);
+        return;
+    }
+#else
+    (void)scratch;
+#endif
+    sort_scalar(keys, index);
+}
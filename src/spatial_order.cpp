@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <utility>
+
+#include "../include/spatial_order.h"
+
+namespace {
+
+constexpr unsigned int CURVE_BITS = 16;
+constexpr uint32_t CURVE_SIDE = uint32_t(1) << CURVE_BITS;
+
+/**
+ * @brief Lleva una coordenada de [0,1] a una celda de la grilla
+ */
+uint32_t quantize(double coordinate)
+{
+    double scaled = coordinate * CURVE_SIDE;
+    if (scaled <= 0.0) return 0;
+    if (scaled >= CURVE_SIDE - 1) return CURVE_SIDE - 1;
+    return static_cast<uint32_t>(scaled);
+}
+
+/**
+ * @brief Separa los 16 bits bajos de v dejando un cero entre cada par
+ */
+uint64_t spread_bits(uint32_t v)
+{
+    uint64_t x = v & 0xFFFF;
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+    return x;
+}
+
+} // namespace
+
+bool parse_vertex_order(const std::string& name, vertex_order& order)
+{
+    if (name == "generation") { order = vertex_order::generation; return true; }
+    if (name == "morton") { order = vertex_order::morton; return true; }
+    if (name == "hilbert") { order = vertex_order::hilbert; return true; }
+    return false;
+}
+
+uint64_t morton_index(const node& p)
+{
+    return spread_bits(quantize(p.x)) | (spread_bits(quantize(p.y)) << 1);
+}
+
+uint64_t hilbert_index(const node& p)
+{
+    uint32_t x = quantize(p.x);
+    uint32_t y = quantize(p.y);
+    uint64_t d = 0;
+    for (uint32_t s = CURVE_SIDE / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += uint64_t(s) * s * ((3 * rx) ^ ry);
+        // Rotar el cuadrante para que la curva quede continua
+        if (ry == 0) {
+            if (rx == 1) {
+                x = CURVE_SIDE - 1 - x;
+                y = CURVE_SIDE - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+std::vector<int> reorder_vertices(std::vector<node>& nodes, vertex_order order)
+{
+    if (order == vertex_order::generation) return {};
+
+    std::vector<std::pair<uint64_t, int>> keys(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        uint64_t key = order == vertex_order::hilbert ? hilbert_index(nodes[i]) : morton_index(nodes[i]);
+        keys[i] = {key, static_cast<int>(i)};
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<node> reordered(nodes.size());
+    std::vector<int> original_ids(nodes.size());
+    for (size_t v = 0; v < keys.size(); ++v) {
+        original_ids[v] = keys[v].second;
+        reordered[v] = nodes[keys[v].second];
+    }
+    nodes.swap(reordered);
+    return original_ids;
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../include/stats.h"
+
+double median(std::vector<double> values)
+{
+    if (values.empty()) return 0.0;
+    size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + mid, values.end());
+    double upper = values[mid];
+    if (values.size() % 2 == 1) return upper;
+    double lower = *std::max_element(values.begin(), values.begin() + mid);
+    return (lower + upper) / 2.0;
+}
+
+double median_absolute_deviation(const std::vector<double>& values)
+{
+    double med = median(values);
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (double v : values) {
+        deviations.push_back(std::abs(v - med));
+    }
+    return median(deviations);
+}
+
+bool is_outlier(double value, double med, double mad)
+{
+    if (mad == 0.0) return value != med;
+    return 0.6745 * std::abs(value - med) / mad > 3.5;
+}
+
+sample_summary summarize(const std::vector<double>& values)
+{
+    sample_summary summary{};
+    summary.count = values.size();
+    if (values.empty()) return summary;
+
+    summary.median = median(values);
+    summary.mad = median_absolute_deviation(values);
+    for (double v : values) {
+        if (is_outlier(v, summary.median, summary.mad)) summary.outliers++;
+    }
+
+    // Intervalo por estadísticos de orden: rangos n/2 -+ 1.96 * sqrt(n) / 2 (base 1)
+    std::vector<double> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    const double n = static_cast<double>(sorted.size());
+    const double half_width = 1.96 * std::sqrt(n) / 2.0;
+    long low_rank = static_cast<long>(std::floor(n / 2.0 - half_width));
+    long high_rank = static_cast<long>(std::ceil(n / 2.0 + half_width)) + 1;
+    low_rank = std::clamp(low_rank, 1L, static_cast<long>(sorted.size()));
+    high_rank = std::clamp(high_rank, 1L, static_cast<long>(sorted.size()));
+    summary.ci95_low = sorted[low_rank - 1];
+    summary.ci95_high = sorted[high_rank - 1];
+    return summary;
+}
+
+std::pair<double, double> bootstrap_median_ratio_ci(const std::vector<double>& numerator, const std::vector<double>& denominator,
+                                                    unsigned int resamples, unsigned int seed, double confidence)
+{
+    if (numerator.empty() || denominator.empty() || resamples == 0) return {0.0, 0.0};
+
+    std::mt19937 gen(seed);
+    auto resample_median = [&](const std::vector<double>& values, std::vector<double>& buffer) {
+        std::uniform_int_distribution<size_t> pick(0, values.size() - 1);
+        for (double& v : buffer) v = values[pick(gen)];
+        return median(buffer);
+    };
+
+    std::vector<double> num_buffer(numerator.size());
+    std::vector<double> den_buffer(denominator.size());
+    std::vector<double> ratios(resamples);
+    for (double& ratio : ratios) {
+        ratio = resample_median(numerator, num_buffer) / resample_median(denominator, den_buffer);
+    }
+    std::sort(ratios.begin(), ratios.end());
+
+    const double tail = (1.0 - confidence) / 2.0;
+    const size_t low = static_cast<size_t>(std::floor(tail * (resamples - 1)));
+    const size_t high = static_cast<size_t>(std::ceil((1.0 - tail) * (resamples - 1)));
+    return {ratios[low], ratios[std::min(high, ratios.size() - 1)]};
+}
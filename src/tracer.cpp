@@ -0,0 +1,122 @@
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../include/tracer.h"
+
+namespace {
+
+/**
+ * @brief Evento "X" (fase completa) de Chrome trace-event
+ */
+struct trace_event
+{
+    const char* name;
+    long long ts_ns;   ///< Inicio desde el origen del tracer
+    long long dur_ns;  ///< Duración
+    std::string detail;
+};
+
+/**
+ * @brief Buffer de eventos de un hilo; sobrevive al hilo porque lo retiene la lista global
+ */
+struct thread_buffer
+{
+    int tid;
+    std::string thread_name;
+    std::vector<trace_event> events;
+};
+
+std::atomic<bool> trace_enabled = false;
+const std::chrono::steady_clock::time_point trace_origin = std::chrono::steady_clock::now();
+
+std::mutex m_buffers;
+std::vector<std::shared_ptr<thread_buffer>> buffers;
+
+thread_buffer& current_buffer()
+{
+    thread_local std::shared_ptr<thread_buffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<thread_buffer>();
+        std::lock_guard lock(m_buffers);
+        buffer->tid = static_cast<int>(buffers.size());
+        buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+std::string json_escape(const std::string& text)
+{
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (c == '\n') { out += "\\n"; continue; }
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+void Tracer::enable()
+{
+    trace_enabled = true;
+}
+
+bool Tracer::enabled()
+{
+    return trace_enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::set_thread_name(const std::string& name)
+{
+    if (!enabled()) return;
+    current_buffer().thread_name = name;
+}
+
+void Tracer::record(const char* name, std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::time_point end, const std::string& detail)
+{
+    long long ts = std::chrono::duration_cast<std::chrono::nanoseconds>(start - trace_origin).count();
+    long long dur = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    current_buffer().events.push_back({name, ts, dur, detail});
+}
+
+bool Tracer::write(const std::string& path)
+{
+    std::ofstream out(path, std::ios::out);
+    if (!out.is_open()) return false;
+
+    std::lock_guard lock(m_buffers);
+    const int pid = static_cast<int>(getpid());
+    bool first = true;
+    auto separator = [&]() -> std::ofstream& {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        return out;
+    };
+
+    // Los tiempos de trace-event van en microsegundos
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (const auto& buffer : buffers) {
+        if (!buffer->thread_name.empty()) {
+            separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid << ",\"tid\":" << buffer->tid
+                        << ",\"args\":{\"name\":\"" << json_escape(buffer->thread_name) << "\"}}";
+        }
+        for (const trace_event& e : buffer->events) {
+            separator() << "{\"ph\":\"X\",\"name\":\"" << json_escape(e.name) << "\",\"pid\":" << pid
+                        << ",\"tid\":" << buffer->tid << ",\"ts\":" << e.ts_ns / 1000.0
+                        << ",\"dur\":" << e.dur_ns / 1000.0;
+            if (!e.detail.empty()) out << ",\"args\":{\"detail\":\"" << json_escape(e.detail) << "\"}";
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+    return out.good();
+}
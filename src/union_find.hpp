@@ -2,6 +2,27 @@
 #define UNION_FIND_HPP
 
 #include <vector>
+#include <algorithm>
+
+/**
+ * Contadores de instrumentación: solo existen si se compila con -DKRUSKAL_STATS
+ * (make STATS=1). Sin esa bandera UF_STAT no genera código.
+ */
+#ifdef KRUSKAL_STATS
+#define UF_STAT(stmt) stmt
+#else
+#define UF_STAT(stmt)
+#endif
+
+/**
+ * @brief Contadores de trabajo de Union-Find (en cero si no se compila con KRUSKAL_STATS)
+ */
+struct union_find_stats {
+    unsigned long long find_calls = 0;        ///< Llamadas a find (incluye las de connected y unite)
+    unsigned long long path_length_total = 0; ///< Suma de saltos padre recorridos por find
+    unsigned long long path_length_max = 0;   ///< Mayor número de saltos de un find
+    unsigned long long compressions = 0;      ///< Punteros padre reescritos por path compression
+};
 
 /**
  * @brief Interfaz para la estructura de datos Union-Find
@@ -43,11 +64,16 @@ private:
     std::vector<int> parent;  ///< Arreglo de padres para estructura de árbol
     std::vector<int> size;    ///< Arreglo de tamaños para union by size
     bool use_path_compression; ///< Flag para activar/desactivar path compression
+    union_find_stats stats;    ///< Contadores de instrumentación
+    UF_STAT(unsigned long long current_path = 0;) ///< Saltos del find en curso
 
     int find_optimized(int x) {
         // Versión con path compression
         if (parent[x] != x) {
-            parent[x] = find_optimized(parent[x]); // Path compression: aplanar árbol
+            UF_STAT(current_path++;)
+            int root = find_optimized(parent[x]);
+            UF_STAT(if (parent[x] != root) stats.compressions++;)
+            parent[x] = root; // Path compression: aplanar árbol
         }
         return parent[x];
     }
@@ -65,21 +91,39 @@ public:
         }
     }
     
+    /**
+     * @brief Vuelve a n conjuntos disjuntos conservando la memoria reservada
+     * @param n Número de elementos (0 a n-1)
+     */
+    void reset(int n) {
+        parent.resize(n);
+        size.assign(n, 1);
+        for (int i = 0; i < n; ++i) {
+            parent[i] = i;
+        }
+    }
+
     /**
      * @brief Encuentra la raíz con o sin path compression según configuración
      * @param x Elemento para encontrar su raíz
      * @return Raíz del conjunto que contiene x
      */
     int find(int x) override {
+        UF_STAT(stats.find_calls++; current_path = 0;)
+        int root;
         if (use_path_compression) {
-            return find_optimized(x);
+            root = find_optimized(x);
         } else {
             // Versión básica sin path compression
             while (parent[x] != x) {
+                UF_STAT(current_path++;)
                 x = parent[x];
             }
-            return x;
+            root = x;
         }
+        UF_STAT(stats.path_length_total += current_path;
+                stats.path_length_max = std::max(stats.path_length_max, current_path);)
+        return root;
     }
 
     /**
@@ -92,14 +136,27 @@ public:
         int rootB = find(b);
         if (rootA == rootB)
             return; // Ya están en el mismo conjunto
+        link(rootA, rootB);
+    }
+
+    /**
+     * @brief Une dos conjuntos a partir de sus raíces (union by size)
+     * Evita repetir los find cuando el llamador ya tiene las raíces.
+     * @param rootA Raíz del primer conjunto
+     * @param rootB Raíz del segundo conjunto (distinta de rootA)
+     * @return Raíz del conjunto unido
+     */
+    int link(int rootA, int rootB) {
         // Union by size: adjuntar árbol más pequeño al más grande
         if (size[rootA] < size[rootB]) {
             parent[rootA] = rootB;
             size[rootB] += size[rootA];
+            return rootB;
         }
         else {
             parent[rootB] = rootA;
             size[rootA] += size[rootB];
+            return rootA;
         }
     }
     
@@ -112,6 +169,22 @@ public:
     bool connected(int a, int b) override {
         return find(a) == find(b);
     }
+
+    /**
+     * @brief Pide a la caché la entrada parent[x] antes de usarla
+     * @param x Elemento que se consultará pronto
+     */
+    void prefetch(int x) const {
+        __builtin_prefetch(&parent[x]);
+    }
+
+    /**
+     * @brief Contadores acumulados desde la construcción
+     * @return Contadores (en cero si no se compila con KRUSKAL_STATS)
+     */
+    const union_find_stats& get_stats() const {
+        return stats;
+    }
 };
 
 // Alias para mantener compatibilidad con código existente
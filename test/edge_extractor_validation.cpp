@@ -12,6 +12,9 @@ int main() {
     // Create an instance of the EdgeExtractor class
     HeapMin heap_min = HeapMin();
     ArraySort array_sorter = ArraySort();
+    // Corridas pequeñas para que 1000 aristas se repartan en varias corridas y hilos
+    RunMerge run_merge = RunMerge(4, 64);
+    SequenceHeap sequence_heap = SequenceHeap();
     std::vector<edge> edges;
     // Generate random edge values for testing purposes
     std::random_device rd;
@@ -21,6 +24,8 @@ int main() {
 
     size_t contador_heap = 0;
     size_t contador_array = 0;
+    size_t contador_run_merge = 0;
+    size_t contador_sequence_heap = 0;
 
     // Insert random edge values into the extractor
     std::cout << "Test: Insertion extractors" << std::endl;
@@ -32,6 +37,8 @@ int main() {
         edge e(u, v, weight);
         heap_min.insert_edge(e);
         array_sorter.insert_edge(e);
+        run_merge.insert_edge(e);
+        sequence_heap.insert_edge(e);
         edges.push_back(e);
     }
 
@@ -43,6 +50,14 @@ int main() {
     {
         std::cout << "Error ArraySort: The number of inserted edges does not match the size of the extractor." << std::endl;
     }
+    if (run_merge.size() != edges.size())
+    {
+        std::cout << "Error RunMerge: The number of inserted edges does not match the size of the extractor." << std::endl;
+    }
+    if (sequence_heap.size() != edges.size())
+    {
+        std::cout << "Error SequenceHeap: The number of inserted edges does not match the size of the extractor." << std::endl;
+    }
     std::cout << "Test passed!" << std::endl;
 
     std::cout << "Test: Clone extractors" << std::endl;
@@ -74,6 +89,70 @@ int main() {
         }
     }
 
+    // A clone taken after partial extraction must continue from the same point
+    RunMerge* run_merge_clone = run_merge.clone();
+    edge primera = run_merge_clone->extract_min();
+    RunMerge* run_merge_partial = run_merge_clone->clone();
+    if (!(*run_merge_partial == *run_merge_clone) || run_merge_partial->extract_min().weight != run_merge_clone->extract_min().weight
+        || primera.weight > run_merge_clone->extract_min().weight){
+        std::cout << "Error: Cloning RunMerge failed." << std::endl;
+    }
+    delete run_merge_partial;
+    delete run_merge_clone;
+
+    // The (weight, index) sort kernels must match std::sort, including padded tails and ties
+    std::cout << "Test: Sort kernels" << std::endl;
+    for (sort_kernel kernel : {sort_kernel::scalar, sort_kernel::avx2})
+    {
+        if (!sort_kernel_supported(kernel)) continue;
+        for (size_t n : {size_t(1), size_t(15), size_t(17), size_t(1000), size_t(70001)})
+        {
+            std::vector<double> keys(n);
+            std::vector<uint32_t> index(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                keys[i] = (i % 3 == 0) ? static_cast<double>(node_dis(gen)) : dis(gen);
+                index[i] = static_cast<uint32_t>(i);
+            }
+            std::vector<double> original = keys;
+            std::vector<double> expected = keys;
+            std::sort(expected.begin(), expected.end());
+            sort_key_index(keys, index, kernel);
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (keys[i] != expected[i] || original[index[i]] != keys[i])
+                {
+                    std::cout << "Error: sort kernel " << sort_kernel_name(kernel) << " failed for n = " << n << "." << std::endl;
+                    break;
+                }
+            }
+        }
+    }
+
+    // clear() after a partial extraction must leave an empty extractor that can be reused
+    std::cout << "Test: Clear and reuse" << std::endl;
+    std::vector<EdgeExtractor*> reusable = {new HeapMin(), new ArraySort(), new RunMerge(4, 64), new SequenceHeap()};
+    for (EdgeExtractor* extractor : reusable)
+    {
+        for (const edge& e : edges) extractor->insert_edge(e);
+        extractor->extract_min();
+        extractor->clear();
+        bool reused = extractor->size() == 0;
+        for (int i = 0; i < 300; ++i) extractor->insert_edge(edges[i]);
+        double previous = -1;
+        for (int i = 0; i < 300 && reused; ++i)
+        {
+            double weight = extractor->extract_min().weight;
+            reused = weight >= previous;
+            previous = weight;
+        }
+        if (!reused || extractor->size() != 0)
+        {
+            std::cout << "Error: " << extractor->get_name() << " is not reusable after clear()." << std::endl;
+        }
+        delete extractor;
+    }
+
     // Delete the cloned objects to avoid memory leaks
     delete heap_min_clone;
     delete array_sorter_clone;
@@ -92,6 +171,8 @@ int main() {
     {
         edge extracted_edge_heap = heap_min.extract_min();
         edge extracted_edge_array_sort = array_sorter.extract_min();
+        edge extracted_edge_run_merge = run_merge.extract_min();
+        edge extracted_edge_sequence_heap = sequence_heap.extract_min();
 
         // Check if the extracted edges match the sorted order by weight
         if (std::abs(extracted_edge_heap.weight - edges[i].weight) < 1e-10)
@@ -102,11 +183,22 @@ int main() {
         {
             contador_array++;
         }
+        if (std::abs(extracted_edge_run_merge.weight - edges[i].weight) < 1e-10)
+        {
+            contador_run_merge++;
+        }
+        if (std::abs(extracted_edge_sequence_heap.weight - edges[i].weight) < 1e-10)
+        {
+            contador_sequence_heap++;
+        }
     }
     std::cout << "Extraction correctly from HeapMin: " << (contador_heap / SIZE_TEST) * 100.0 << "%" << std::endl;
     std::cout << "Extraction correctly from ArraySort: " << (contador_array / SIZE_TEST) * 100.0 << "%" << std::endl;
+    std::cout << "Extraction correctly from RunMerge: " << (contador_run_merge / SIZE_TEST) * 100.0 << "%" << std::endl;
+    std::cout << "Extraction correctly from SequenceHeap: " << (contador_sequence_heap / SIZE_TEST) * 100.0 << "%" << std::endl;
 
-    if ((contador_heap == contador_array) && (contador_heap == SIZE_TEST))
+    if ((contador_heap == contador_array) && (contador_heap == SIZE_TEST) && (contador_run_merge == SIZE_TEST)
+        && (contador_sequence_heap == SIZE_TEST))
     {
         std::cout << "Test passed!" << std::endl;
     }
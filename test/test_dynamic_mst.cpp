@@ -0,0 +1,116 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#include "../include/utils.h"
+#include "../include/edge_extractor.h"
+#include "../include/kruskal.h"
+#include "../include/dynamic_mst.h"
+
+/**
+ * @brief Peso del bosque cobertor mínimo recalculado desde cero con kruskal()
+ * @param mst Estructura dinámica de la que se toma el grafo actual
+ * @return Peso total del bosque mínimo
+ */
+double recompute_weight(const DynamicMST& mst) {
+    ArraySort extractor;
+    for (const edge& e : mst.graph_edges()) {
+        extractor.insert_edge(e);
+    }
+    void* resultado = kruskal(&extractor, true, kruskal_options{KRUSKAL_DEFAULT_BATCH, mst.vertex_count()});
+    double peso = get_mst_weight(resultado);
+    free_kruskal_result(resultado);
+    return peso;
+}
+
+int main()
+{
+    std::cout << "=== PRUEBA DEL MST DINÁMICO ===" << std::endl;
+
+    const int N_INICIAL = 150;
+    const int OPERACIONES = 1500;
+    std::mt19937 gen(2025);
+    std::uniform_real_distribution<double> distrib(0.0, 1.0);
+
+    std::vector<node> puntos;
+    std::vector<int> vivos;
+    DynamicMST mst;
+
+    // Agrega un punto nuevo con aristas candidatas hacia todos los puntos vivos
+    auto agregar_punto = [&]() {
+        node p = {distrib(gen), distrib(gen)};
+        std::vector<std::pair<int, double>> candidatas;
+        for (int v : vivos) {
+            candidatas.emplace_back(v, distance(p, puntos[v]));
+        }
+        int id = mst.insert_vertex(candidatas);
+        puntos.push_back(p);
+        vivos.push_back(id);
+    };
+
+    for (int i = 0; i < N_INICIAL; ++i) {
+        agregar_punto();
+    }
+
+    int errores = 0;
+    double tiempo_dinamico = 0.0;
+    double tiempo_recalculo = 0.0;
+    const char* nombres[] = {"inserción de vértice", "borrado de vértice", "cambio de peso", "borrado de arista", "inserción de arista"};
+    int conteo[5] = {0, 0, 0, 0, 0};
+
+    for (int op = 0; op < OPERACIONES; ++op) {
+        int tipo = gen() % 5;
+        int u = vivos[gen() % vivos.size()];
+        int v = vivos[gen() % vivos.size()];
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        if (tipo == 0) {
+            agregar_punto();
+        } else if (tipo == 1 && vivos.size() > 2) {
+            mst.delete_vertex(u);
+            vivos.erase(std::find(vivos.begin(), vivos.end(), u));
+        } else if (tipo == 2 && mst.has_edge(u, v)) {
+            mst.update_weight(u, v, distrib(gen) * 2.0);
+        } else if (tipo == 3 && mst.has_edge(u, v)) {
+            mst.delete_edge(u, v);
+        } else if (tipo == 4 && u != v) {
+            mst.insert_edge(u, v, distrib(gen) * 0.01);
+        } else {
+            continue;
+        }
+        auto fin = std::chrono::high_resolution_clock::now();
+        tiempo_dinamico += std::chrono::duration<double, std::micro>(fin - inicio).count();
+        conteo[tipo]++;
+
+        // Verificación contra el recálculo completo
+        inicio = std::chrono::high_resolution_clock::now();
+        double esperado = recompute_weight(mst);
+        fin = std::chrono::high_resolution_clock::now();
+        tiempo_recalculo += std::chrono::duration<double, std::micro>(fin - inicio).count();
+
+        if (std::abs(esperado - mst.weight()) > 1e-9) {
+            std::cout << "❌ ERROR en la operación " << op << " (" << nombres[tipo] << "): peso dinámico "
+                      << mst.weight() << ", recalculado " << esperado << std::endl;
+            errores++;
+        }
+    }
+
+    int total = 0;
+    for (int i = 0; i < 5; ++i) {
+        std::cout << "  - " << nombres[i] << ": " << conteo[i] << std::endl;
+        total += conteo[i];
+    }
+    std::cout << "Vértices vivos al final: " << vivos.size() << ", aristas del bosque: " << mst.tree_size() << std::endl;
+    std::cout << "Tiempo medio por actualización: " << tiempo_dinamico / total << " µs" << std::endl;
+    std::cout << "Tiempo medio por recálculo con kruskal(): " << tiempo_recalculo / total << " µs" << std::endl;
+
+    if (errores == 0) {
+        std::cout << "✅ ÉXITO: El MST dinámico coincide con el recálculo en las " << total << " operaciones" << std::endl;
+        return 0;
+    }
+    std::cout << "❌ ERROR: " << errores << " operaciones no coinciden con el recálculo" << std::endl;
+    return 1;
+}
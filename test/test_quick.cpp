@@ -2,10 +2,31 @@
 #include <vector>
 #include <random>
 #include <chrono>
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
 
 #include "../include/utils.h"
 #include "../include/edge_extractor.h"
 #include "../include/kruskal.h"
+#include "../include/edge_generation.h"
+#include "../include/batch_mst.h"
+#include "../include/boruvka_emst.h"
+#include "../include/spatial_order.h"
+
+/**
+ * @brief Métrica de usuario para la prueba: L2 al cuadrado con el eje x pesado por 4 (sin kernel AVX2)
+ */
+struct x_pesado
+{
+    static constexpr double max_weight = 5.0;
+    static constexpr double distance(const node& a, const node& b)
+    {
+        return 4 * (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+    }
+    static double radius(double weight) { return std::sqrt(weight); }
+    static constexpr double weight(double radius) { return radius * radius; }
+};
 
 int main()
 {
@@ -91,6 +112,195 @@ int main()
         }
     }
     
+    // Generación acotada por radio: debe dar el mismo MST con muchas menos aristas
+    edge_vector aristas_radio;
+    radius_generation generacion = generate_spanning_radius_edges(nodes, 2.0, aristas_radio);
+    ArraySort extractor_radio;
+    for (const auto& e : aristas_radio) {
+        extractor_radio.insert_edge(e);
+    }
+    void* resultado_radio = kruskal(&extractor_radio, true, kruskal_options{KRUSKAL_DEFAULT_BATCH, N, true});
+    std::cout << "Modo radius (umbral " << generacion.threshold << ", " << generacion.attempts << " intento(s)): "
+              << aristas_radio.size() << " aristas, peso MST " << get_mst_weight(resultado_radio) << std::endl;
+    if (get_mst_edge_count(resultado_radio) != N - 1 || std::abs(get_mst_weight(resultado_radio) - pesos_mst[0]) > 1e-10) {
+        todas_iguales = false;
+    }
+
+    // Consultas minimax del árbol de reconstrucción contra un recorrido del MST
+    std::vector<std::vector<std::pair<int, double>>> adyacencia(N);
+    for (const edge& e : get_mst_edges(resultado_radio)) {
+        adyacencia[e.u].emplace_back(e.v, e.weight);
+        adyacencia[e.v].emplace_back(e.u, e.weight);
+    }
+    int consultas_erroneas = 0;
+    for (int q = 0; q < 200; ++q) {
+        int u = gen() % N;
+        int v = gen() % N;
+        // Máximo del camino u–v por DFS desde u
+        std::vector<double> maximo(N, -1.0);
+        std::vector<int> pila = {u};
+        maximo[u] = 0.0;
+        while (!pila.empty()) {
+            int x = pila.back();
+            pila.pop_back();
+            for (const auto& [y, w] : adyacencia[x]) {
+                if (maximo[y] < 0) {
+                    maximo[y] = std::max(maximo[x], w);
+                    pila.push_back(y);
+                }
+            }
+        }
+        if (std::abs(maximo[v] - get_bottleneck_weight(resultado_radio, u, v)) > 1e-12) {
+            consultas_erroneas++;
+        }
+    }
+    std::cout << "Consultas minimax (árbol de reconstrucción): " << 200 - consultas_erroneas << "/200 correctas" << std::endl;
+    if (consultas_erroneas > 0) {
+        todas_iguales = false;
+    }
+
+    // k-clustering: u y v comparten cluster si y solo si su arista minimax no supera la distancia de corte
+    const int k = 5;
+    ArraySort extractor_clusters;
+    for (const auto& e : aristas_radio) {
+        extractor_clusters.insert_edge(e);
+    }
+    void* resultado_clusters = kruskal(&extractor_clusters, true, kruskal_options{KRUSKAL_DEFAULT_BATCH, N, false, k});
+    std::vector<int> etiquetas = get_cluster_labels(resultado_clusters);
+    double corte = get_merge_distance(resultado_clusters);
+    int etiquetas_erroneas = 0;
+    for (int u = 0; u < N; ++u) {
+        if (etiquetas[u] < 0 || etiquetas[u] >= k) etiquetas_erroneas++;
+        for (int v = u + 1; v < N; ++v) {
+            bool mismo = etiquetas[u] == etiquetas[v];
+            if (mismo != (get_bottleneck_weight(resultado_radio, u, v) <= corte)) etiquetas_erroneas++;
+        }
+    }
+    std::cout << "k-clustering (k=" << k << ", corte " << corte << "): "
+              << (etiquetas_erroneas == 0 ? "etiquetas consistentes con el MST" : "etiquetas inconsistentes") << std::endl;
+    if (etiquetas_erroneas > 0 || get_mst_edge_count(resultado_clusters) != 0) {
+        todas_iguales = false;
+    }
+    free_kruskal_result(resultado_clusters);
+    free_kruskal_result(resultado_radio);
+
+    // Lote de instancias chicas (más una no conexa): mismo peso y tamaño que kruskal() por separado
+    MSTBatch lote;
+    std::vector<double> pesos_lote;
+    std::vector<int> tamanos_lote;
+    for (int instancia = 0; instancia < 100; ++instancia) {
+        std::vector<node> puntos(8 + instancia * 3);
+        for (auto& p : puntos) p = {distrib(gen), distrib(gen)};
+        lote.add_points(puntos);
+        ArraySort extractor_lote;
+        const edge* aristas_lote = lote.instance_edges(instancia);
+        for (size_t i = 0; i < lote.instance_edge_count(instancia); ++i) extractor_lote.insert_edge(aristas_lote[i]);
+        void* resultado_lote = kruskal(&extractor_lote, instancia % 2 == 0, kruskal_options{KRUSKAL_DEFAULT_BATCH, static_cast<int>(puntos.size())});
+        pesos_lote.push_back(get_mst_weight(resultado_lote));
+        tamanos_lote.push_back(get_mst_edge_count(resultado_lote));
+        free_kruskal_result(resultado_lote);
+    }
+    const std::vector<edge> bosque = {{0, 1, 0.5}, {2, 3, 0.25}, {1, 0, 0.75}};
+    lote.add_instance(5, bosque.data(), bosque.size());
+    pesos_lote.push_back(0.75);
+    tamanos_lote.push_back(2);
+    mst_batch_result resultado_batch = solve_mst_batch(lote, true, 2);
+    int instancias_erroneas = 0;
+    for (size_t i = 0; i < lote.size(); ++i) {
+        if (std::abs(resultado_batch.weight[i] - pesos_lote[i]) > 1e-9 || resultado_batch.mst_size[i] != tamanos_lote[i]) {
+            instancias_erroneas++;
+        }
+    }
+    std::cout << "Lote de " << lote.size() << " instancias: " << lote.size() - instancias_erroneas << " coinciden con kruskal()" << std::endl;
+    if (instancias_erroneas > 0 || resultado_batch.mst_edges.size() != resultado_batch.first_mst_edge.back() + 2) {
+        todas_iguales = false;
+    }
+
+    // Políticas de métrica: con cada una, el MST de las aristas acotadas por radio coincide con el del grafo completo
+    std::vector<node> puntos_metrica(nodes.begin(), nodes.begin() + 1024);
+    auto probar_metrica = [&](const char* nombre, auto metrica) {
+        using Metric = decltype(metrica);
+        double pesos[2];
+        edge_vector aristas[2];
+        generate_complete_edges<Metric>(puntos_metrica, aristas[0]);
+        radius_generation gen_metrica = generate_spanning_radius_edges<Metric>(puntos_metrica, 2.0, aristas[1]);
+        bool kernel_ok = std::abs(aristas[0][777].weight - Metric::distance(puntos_metrica[aristas[0][777].u], puntos_metrica[aristas[0][777].v])) < 1e-15;
+        for (int modo = 0; modo < 2; ++modo) {
+            ArraySort extractor_metrica;
+            for (const auto& e : aristas[modo]) extractor_metrica.insert_edge(e);
+            void* resultado_metrica = kruskal(&extractor_metrica, true, kruskal_options{KRUSKAL_DEFAULT_BATCH, 1024});
+            pesos[modo] = get_mst_weight(resultado_metrica);
+            free_kruskal_result(resultado_metrica);
+        }
+        std::cout << "Métrica " << nombre << ": peso MST " << pesos[0] << " (radius: " << aristas[1].size() << " aristas, "
+                  << gen_metrica.attempts << " intento(s))" << std::endl;
+        if (!kernel_ok || std::abs(pesos[0] - pesos[1]) > 1e-10) todas_iguales = false;
+    };
+    probar_metrica("sqeuclidean", squared_l2{});
+    probar_metrica("l1", l1_distance{});
+    probar_metrica("linf", linf_distance{});
+    probar_metrica("usuario", x_pesado{});
+
+    // Renumeración por curva: con el mapeo a ids originales, el MST es el mismo conjunto de aristas
+    auto aristas_mst_ordenadas = [](std::vector<edge> aristas) {
+        for (edge& e : aristas) {
+            if (e.u > e.v) std::swap(e.u, e.v);
+        }
+        std::sort(aristas.begin(), aristas.end(), [](const edge& a, const edge& b) {
+            return std::tie(a.u, a.v) < std::tie(b.u, b.v);
+        });
+        return aristas;
+    };
+    auto mst_con_orden = [&](vertex_order orden) {
+        std::vector<node> puntos = puntos_metrica;
+        const std::vector<int> ids_originales = reorder_vertices(puntos, orden);
+        edge_vector aristas;
+        generate_complete_edges(puntos, aristas);
+        ArraySort extractor_orden;
+        for (const auto& e : aristas) extractor_orden.insert_edge(e);
+        void* resultado_orden = kruskal(&extractor_orden, true, kruskal_options{KRUSKAL_DEFAULT_BATCH, 1024});
+        set_vertex_mapping(resultado_orden, ids_originales);
+        std::vector<edge> mst = aristas_mst_ordenadas(get_mst_edges(resultado_orden));
+        free_kruskal_result(resultado_orden);
+        return mst;
+    };
+    const std::vector<edge> mst_generacion = mst_con_orden(vertex_order::generation);
+    for (const auto& [nombre, orden] : {std::pair{"morton", vertex_order::morton}, std::pair{"hilbert", vertex_order::hilbert}}) {
+        const std::vector<edge> mst = mst_con_orden(orden);
+        bool iguales = mst.size() == mst_generacion.size();
+        for (size_t i = 0; iguales && i < mst.size(); ++i) {
+            iguales = mst[i].u == mst_generacion[i].u && mst[i].v == mst_generacion[i].v
+                   && mst[i].weight == distance(puntos_metrica[mst[i].u], puntos_metrica[mst[i].v]);
+        }
+        std::cout << "Orden " << nombre << ": " << (iguales ? "MST con ids originales igual al de generación" : "MST distinto") << std::endl;
+        if (!iguales) todas_iguales = false;
+    }
+
+    // Borůvka dual-tree en varias dimensiones (con puntos repetidos): mismo peso que kruskal() sobre el grafo completo
+    auto probar_emst = [&](auto dimension, auto metrica, const char* nombre) {
+        constexpr size_t D = decltype(dimension)::value;
+        using Metric = decltype(metrica);
+        PointSet<D> puntos = PointSet<D>::uniform(600, gen);
+        for (size_t i = 0; i < 50; ++i) {
+            for (size_t d = 0; d < D; ++d) puntos(300 + i, d) = puntos(i, d);
+        }
+        const emst_result arbol = dual_tree_boruvka<D, Metric>(puntos);
+        edge_vector completas;
+        generate_complete_edges<Metric>(puntos, completas);
+        ArraySort extractor_emst;
+        for (const auto& e : completas) extractor_emst.insert_edge(e);
+        void* resultado_emst = kruskal(&extractor_emst, true, kruskal_options{KRUSKAL_DEFAULT_BATCH, 600});
+        const double esperado = get_mst_weight(resultado_emst);
+        free_kruskal_result(resultado_emst);
+        std::cout << "Borůvka dual-tree D=" << D << " " << nombre << ": peso " << arbol.weight << " (kruskal " << esperado
+                  << ", " << arbol.rounds << " rondas, " << arbol.distance_evaluations << " distancias)" << std::endl;
+        if (arbol.edges.size() != 599 || std::abs(arbol.weight - esperado) > 1e-9 * std::max(1.0, esperado)) todas_iguales = false;
+    };
+    probar_emst(std::integral_constant<size_t, 2>{}, squared_l2{}, "sqeuclidean");
+    probar_emst(std::integral_constant<size_t, 3>{}, l1_distance{}, "l1");
+    probar_emst(std::integral_constant<size_t, 8>{}, squared_l2{}, "sqeuclidean");
+    probar_emst(std::integral_constant<size_t, 16>{}, linf_distance{}, "linf");
+
     if (todas_iguales) {
         std::cout << "✅ ÉXITO: Todas las variantes producen el mismo MST" << std::endl;
         std::cout << "✅ ÉXITO: El sistema está funcionando correctamente" << std::endl;